@@ -0,0 +1,444 @@
+/* Guest side of scripts/qemu-system-vm.
+
+   This program is /init of the test VM.  It mounts the host directories that
+   are shared over virtio-9p at the same absolute path they have on the host,
+   then executes the programs it is asked to run over the rvtest.ctl
+   virtio-serial port.  Requests are "<length>\n" followed by NUL separated
+   fields:
+
+     run  <id> <cwd> <stdout> <stderr> <nenv> <env>... <argc> <argv>...
+     kill <id> <signal>
+     halt
+
+   and every finished program is reported back as "<id> exit <code>\n" or
+   "<id> signal <number>\n".  It has to be linked statically, the initramfs
+   does not contain a shell.  */
+
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <net/if.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mount.h>
+#include <sys/reboot.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define PORT_NAME "rvtest.ctl"
+#define MAX_JOBS 4096
+
+extern char **environ;
+
+struct job
+{
+  char id[32];
+  pid_t pid;
+};
+
+static struct job jobs[MAX_JOBS];
+static int port_fd = -1;
+
+static void
+die (const char *what)
+{
+  fprintf (stderr, "qemu-system-vm-agent: %s: %s\n", what, strerror (errno));
+  sync ();
+  reboot (RB_POWER_OFF);
+  for (;;)
+    pause ();
+}
+
+static void
+mkdir_p (const char *path)
+{
+  char buf[4096];
+  size_t len = strlen (path);
+
+  if (len >= sizeof buf)
+    return;
+  memcpy (buf, path, len + 1);
+  for (char *p = buf + 1; *p; p++)
+    if (*p == '/')
+      {
+	*p = '\0';
+	mkdir (buf, 0755);
+	*p = '/';
+      }
+  mkdir (buf, 0755);
+}
+
+static void
+mount_fs (const char *source, const char *target, const char *type,
+	  const char *data)
+{
+  mkdir_p (target);
+  if (mount (source, target, type, 0, data) != 0)
+    fprintf (stderr, "qemu-system-vm-agent: mount %s on %s: %s\n",
+	     source, target, strerror (errno));
+}
+
+/* Mount every "rvtest.share=" directory from the kernel command line.  */
+static void
+mount_shares (void)
+{
+  static char cmdline[8192];
+  int fd = open ("/proc/cmdline", O_RDONLY);
+  ssize_t len;
+  char *shares, *save, *dir;
+  int n = 0;
+
+  if (fd < 0)
+    die ("/proc/cmdline");
+  len = read (fd, cmdline, sizeof cmdline - 1);
+  close (fd);
+  if (len <= 0)
+    return;
+  cmdline[len] = '\0';
+
+  shares = strstr (cmdline, "rvtest.share=");
+  if (shares == NULL)
+    return;
+  shares += strlen ("rvtest.share=");
+  shares[strcspn (shares, " \n")] = '\0';
+
+  for (dir = strtok_r (shares, ",", &save); dir != NULL;
+       dir = strtok_r (NULL, ",", &save))
+    {
+      char tag[32];
+      snprintf (tag, sizeof tag, "share%d", n++);
+      mount_fs (tag, dir, "9p", "trans=virtio,version=9p2000.L,"
+		"cache=mmap,msize=524288");
+    }
+}
+
+/* Some glibc tests talk to themselves over the loopback interface.  */
+static void
+loopback_up (void)
+{
+  struct ifreq ifr;
+  int fd = socket (AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+  if (fd < 0)
+    return;
+  memset (&ifr, 0, sizeof ifr);
+  strcpy (ifr.ifr_name, "lo");
+  if (ioctl (fd, SIOCGIFFLAGS, &ifr) == 0)
+    {
+      ifr.ifr_flags |= IFF_UP;
+      ioctl (fd, SIOCSIFFLAGS, &ifr);
+    }
+  close (fd);
+}
+
+/* Find the /dev node of the virtio-serial port named PORT_NAME.  */
+static int
+open_port (void)
+{
+  char path[512], name[64];
+  struct dirent *de;
+  DIR *dir = opendir ("/sys/class/virtio-ports");
+
+  if (dir == NULL)
+    die ("/sys/class/virtio-ports");
+  while ((de = readdir (dir)) != NULL)
+    {
+      int fd;
+      ssize_t len;
+
+      if (de->d_name[0] == '.')
+	continue;
+      snprintf (path, sizeof path, "/sys/class/virtio-ports/%s/name",
+		de->d_name);
+      fd = open (path, O_RDONLY);
+      if (fd < 0)
+	continue;
+      len = read (fd, name, sizeof name - 1);
+      close (fd);
+      if (len <= 0)
+	continue;
+      name[len] = '\0';
+      name[strcspn (name, "\n")] = '\0';
+      if (strcmp (name, PORT_NAME) == 0)
+	{
+	  snprintf (path, sizeof path, "/dev/%s", de->d_name);
+	  closedir (dir);
+	  fd = open (path, O_RDWR | O_CLOEXEC);
+	  if (fd < 0)
+	    die (path);
+	  return fd;
+	}
+    }
+  errno = ENOENT;
+  die ("virtio-serial port " PORT_NAME);
+  return -1;
+}
+
+static void
+reply (const char *fmt, ...)
+{
+  char buf[128];
+  va_list ap;
+  int len;
+
+  va_start (ap, fmt);
+  len = vsnprintf (buf, sizeof buf, fmt, ap);
+  va_end (ap);
+  /* Nobody listening is fine, the broker will not wait for us then.  */
+  if (write (port_fd, buf, len) < 0 && errno != EPIPE)
+    fprintf (stderr, "qemu-system-vm-agent: write: %s\n", strerror (errno));
+}
+
+static struct job *
+find_job_by_id (const char *id)
+{
+  for (int i = 0; i < MAX_JOBS; i++)
+    if (jobs[i].pid > 0 && strcmp (jobs[i].id, id) == 0)
+      return &jobs[i];
+  return NULL;
+}
+
+static void
+redirect (int fd, const char *path, int flags)
+{
+  int nfd = open (path, flags, 0644);
+  if (nfd < 0)
+    {
+      dprintf (2, "qemu-system-vm-agent: %s: %s\n", path, strerror (errno));
+      _exit (126);
+    }
+  if (nfd != fd)
+    {
+      dup2 (nfd, fd);
+      close (nfd);
+    }
+}
+
+static void
+start_job (char **field, int nfield)
+{
+  /* run <id> <cwd> <stdout> <stderr> <nenv> <env>... <argc> <argv>...  */
+  char **envp, **argv;
+  int nenv, argc, slot;
+  sigset_t mask;
+  pid_t pid;
+
+  if (nfield < 7)
+    return;
+  nenv = atoi (field[5]);
+  if (nenv < 0 || 6 + nenv >= nfield)
+    return;
+  argc = atoi (field[6 + nenv]);
+  if (argc <= 0 || 7 + nenv + argc > nfield)
+    return;
+
+  for (slot = 0; slot < MAX_JOBS && jobs[slot].pid > 0; slot++)
+    ;
+  if (slot == MAX_JOBS)
+    {
+      reply ("%s exit 125\n", field[1]);
+      return;
+    }
+
+  /* The fields are NUL terminated in place; build the NULL terminated
+     vectors execvp wants.  */
+  envp = calloc (nenv + 1, sizeof (char *));
+  argv = calloc (argc + 1, sizeof (char *));
+  if (envp == NULL || argv == NULL)
+    die ("calloc");
+  memcpy (envp, &field[6], nenv * sizeof (char *));
+  memcpy (argv, &field[7 + nenv], argc * sizeof (char *));
+
+  pid = fork ();
+  if (pid == 0)
+    {
+      sigemptyset (&mask);
+      sigprocmask (SIG_SETMASK, &mask, NULL);
+      setsid ();
+      redirect (0, "/dev/null", O_RDONLY);
+      redirect (1, field[3], O_WRONLY | O_CREAT | O_TRUNC);
+      redirect (2, field[4], O_WRONLY | O_CREAT | O_TRUNC);
+      if (chdir (field[2]) != 0)
+	{
+	  dprintf (2, "qemu-system-vm-agent: chdir %s: %s\n", field[2],
+		   strerror (errno));
+	  _exit (126);
+	}
+      environ = envp;
+      execvp (argv[0], argv);
+      dprintf (2, "qemu-system-vm-agent: %s: %s\n", argv[0], strerror (errno));
+      _exit (errno == ENOENT ? 127 : 126);
+    }
+  free (envp);
+  free (argv);
+
+  if (pid < 0)
+    {
+      reply ("%s exit 125\n", field[1]);
+      return;
+    }
+  snprintf (jobs[slot].id, sizeof jobs[slot].id, "%s", field[1]);
+  jobs[slot].pid = pid;
+}
+
+static void
+handle_frame (char *payload, size_t len)
+{
+  char *field[8192];
+  int nfield = 0;
+  char *p = payload;
+
+  do
+    {
+      field[nfield++] = p;
+      p += strlen (p) + 1;
+    }
+  while (p <= payload + len && nfield < 8192);
+
+  if (strcmp (field[0], "run") == 0)
+    start_job (field, nfield);
+  else if (strcmp (field[0], "kill") == 0 && nfield == 3)
+    {
+      struct job *job = find_job_by_id (field[1]);
+      if (job != NULL)
+	{
+	  kill (-job->pid, atoi (field[2]));
+	  kill (job->pid, atoi (field[2]));
+	}
+    }
+  else if (strcmp (field[0], "halt") == 0)
+    {
+      sync ();
+      reboot (RB_POWER_OFF);
+    }
+}
+
+/* Collect exited children; as PID 1 this includes orphans.  */
+static void
+reap (void)
+{
+  int status;
+  pid_t pid;
+
+  while ((pid = waitpid (-1, &status, WNOHANG)) > 0)
+    for (int i = 0; i < MAX_JOBS; i++)
+      if (jobs[i].pid == pid)
+	{
+	  if (WIFSIGNALED (status))
+	    reply ("%s signal %d\n", jobs[i].id, WTERMSIG (status));
+	  else
+	    reply ("%s exit %d\n", jobs[i].id, WEXITSTATUS (status));
+	  jobs[i].pid = 0;
+	  break;
+	}
+}
+
+int
+main (void)
+{
+  static char buf[1 << 20];
+  size_t used = 0;
+  int connected = 0;
+  struct pollfd pfd[2];
+  sigset_t mask;
+  int sfd;
+
+  mount_fs ("proc", "/proc", "proc", NULL);
+  mount_fs ("sysfs", "/sys", "sysfs", NULL);
+  mount_fs ("devtmpfs", "/dev", "devtmpfs", NULL);
+  mount_fs ("devpts", "/dev/pts", "devpts", "ptmxmode=0666,mode=0620");
+  mount_fs ("tmpfs", "/dev/shm", "tmpfs", NULL);
+  mount_fs ("tmpfs", "/tmp", "tmpfs", NULL);
+  mount_shares ();
+  loopback_up ();
+
+  sigemptyset (&mask);
+  sigaddset (&mask, SIGCHLD);
+  sigprocmask (SIG_BLOCK, &mask, NULL);
+  sfd = signalfd (-1, &mask, SFD_CLOEXEC | SFD_NONBLOCK);
+  if (sfd < 0)
+    die ("signalfd");
+
+  port_fd = open_port ();
+  pfd[0].fd = port_fd;
+  pfd[1].fd = sfd;
+  pfd[1].events = POLLIN;
+
+  for (;;)
+    {
+      /* The broker sends nothing before it has read READY, and a connected
+	 port with nothing to read reports neither POLLIN nor POLLHUP, so
+	 wait for it to become writable until the connection is greeted.  */
+      pfd[0].events = connected ? POLLIN : POLLIN | POLLOUT;
+      if (poll (pfd, 2, -1) < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  die ("poll");
+	}
+
+      if (pfd[1].revents & POLLIN)
+	{
+	  struct signalfd_siginfo si;
+	  while (read (sfd, &si, sizeof si) == sizeof si)
+	    ;
+	  reap ();
+	}
+
+      /* The port reports POLLHUP while no broker is connected on the host
+	 side; greet every new connection.  */
+      if (pfd[0].revents & POLLHUP)
+	{
+	  connected = 0;
+	  used = 0;
+	  usleep (100000);
+	  continue;
+	}
+      if (!connected && (pfd[0].revents & (POLLIN | POLLOUT)))
+	{
+	  connected = 1;
+	  reply ("READY\n");
+	}
+
+      if (pfd[0].revents & POLLIN)
+	{
+	  ssize_t n = read (port_fd, buf + used, sizeof buf - used);
+	  if (n <= 0)
+	    continue;
+	  used += n;
+
+	  for (;;)
+	    {
+	      char *nl = memchr (buf, '\n', used);
+	      size_t hdr, len;
+
+	      if (nl == NULL)
+		break;
+	      hdr = nl - buf + 1;
+	      len = strtoul (buf, NULL, 10);
+	      if (hdr + len >= sizeof buf)
+		die ("request too large");
+	      if (used < hdr + len)
+		break;
+	      /* Terminate the last field in place.  */
+	      {
+		char saved = buf[hdr + len];
+		buf[hdr + len] = '\0';
+		handle_frame (buf + hdr, len);
+		buf[hdr + len] = saved;
+	      }
+	      memmove (buf, buf + hdr + len, used - hdr - len);
+	      used -= hdr + len;
+	    }
+	}
+    }
+}
@@ -0,0 +1,17 @@
+/* Appended to libatomic_i.h by scripts/make-libatomic-overlay.
+
+   In the translation units that define libatomic's double-word operations
+   (load_n.c and the others built with N=16 on RV64, N=8 on RV32), give
+   what they define a _lock suffix: libat_load_16_lock, exported as
+   __atomic_load_16_lock, and so on.  target-opt-zacas.c then defines
+   libat_load_16 and __atomic_load_16 as IFUNCs that pick amocas or these
+   locked versions.  Everything libatomic names after N goes through SIZE,
+   so the exported alias and its target stay in step; libatomic.map does
+   not list the _lock names, so libatomic.so keeps them local.  */
+
+#if defined (N) && defined (__riscv_xlen) && N * 4 == __riscv_xlen
+# define TARGET_OPT_LOCKED_(x, n) x##_##n##_lock
+# define TARGET_OPT_LOCKED(x, n) TARGET_OPT_LOCKED_ (x, n)
+# undef SIZE
+# define SIZE(X) TARGET_OPT_LOCKED (X, N)
+#endif
@@ -0,0 +1,224 @@
+/* Lock-free double-word atomics for libatomic with Zacas: the 16-byte
+   operations with amocas.q on RV64 and the 8-byte ones with amocas.d on
+   RV32, which libatomic otherwise implements by taking a lock.
+
+   Every double-word operation is replaced, not just compare-and-exchange,
+   because a lock-free CAS racing with a locked fetch-and-add would not be
+   atomic.  Both libatomic's exported names (__atomic_load_16, ...) and the
+   internal ones its generic routines call (libat_load_16, ...) are
+   defined, so that __atomic_load (16, ...) goes the same way.  Every
+   operation is sequentially consistent, whatever the memory model asked
+   for.
+
+   Built with -DTARGET_OPT_IFUNC (for glibc), this file is part of
+   libatomic itself, see scripts/make-libatomic-overlay, so libatomic.a and
+   libatomic.so dispatch the same way.  Each operation is an IFUNC that
+   picks the amocas version when riscv_hwprobe reports Zacas, and
+   libatomic's own one otherwise, which libatomic-locked.h has renamed to
+   libat_load_16_lock and so on.  Built without it (for newlib), the amocas
+   versions are defined directly if the march includes Zacas, and nothing
+   is defined otherwise.  __target_opt_atomic_zacas tells programs which
+   way they went.
+   Only a0-a5 are used as register pairs, so this works for RV32E/RV64E as
+   well.  */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined (TARGET_OPT_IFUNC) || defined (__riscv_zacas)
+
+#if __riscv_xlen == 64
+# define N 16
+# define AMOCAS "amocas.q.aqrl"
+typedef unsigned __int128 U;
+#else
+# define N 8
+# define AMOCAS "amocas.d.aqrl"
+typedef uint64_t U;
+#endif
+
+#define PASTE_(a, b) a##b
+#define PASTE(a, b) PASTE_ (a, b)
+#define SIZED__(op, n) op##_##n
+#define SIZED_(op, n) SIZED__ (op, n)
+#define SIZED(op) SIZED_ (op, N)
+#define HALF_BITS (N * 4)
+
+/* Compare *P with EXPECTED and store DESIRED if they are equal.  Returns
+   the old value of *P.  The pairs must be even/odd registers.  */
+static inline U
+cas (U *p, U expected, U desired)
+{
+  register unsigned long lo __asm__ ("a2") = expected;
+  register unsigned long hi __asm__ ("a3") = expected >> HALF_BITS;
+  register unsigned long new_lo __asm__ ("a4") = desired;
+  register unsigned long new_hi __asm__ ("a5") = desired >> HALF_BITS;
+
+  __asm__ volatile (".option push\n\t"
+		    ".option arch, +zacas\n\t"
+		    AMOCAS "\t%0, %2, (%4)\n\t"
+		    ".option pop"
+		    : "+r" (lo), "+r" (hi)
+		    : "r" (new_lo), "r" (new_hi), "r" (p)
+		    : "memory");
+  return ((U) hi << HALF_BITS) | lo;
+}
+
+/* A CAS that writes back the value it read is an atomic load.  It needs
+   write access, like libatomic's own lock-free loads on other targets.  */
+static U
+zacas_load (U *p, int model)
+{
+  (void) model;
+  return cas (p, 0, 0);
+}
+
+static U
+zacas_exchange (U *p, U val, int model)
+{
+  U old = zacas_load (p, model);
+  U prev;
+
+  while ((prev = cas (p, old, val)) != old)
+    old = prev;
+  return old;
+}
+
+static void
+zacas_store (U *p, U val, int model)
+{
+  zacas_exchange (p, val, model);
+}
+
+static bool
+zacas_compare_exchange (U *p, U *expected, U desired, int smodel,
+			int fmodel)
+{
+  U old = cas (p, *expected, desired);
+
+  (void) smodel;
+  (void) fmodel;
+  if (old == *expected)
+    return true;
+  *expected = old;
+  return false;
+}
+
+#define FETCH_OP(op, expr)						\
+  static U								\
+  zacas_fetch_##op (U *p, U val, int model)				\
+  {									\
+    U old = zacas_load (p, model);					\
+    U prev;								\
+									\
+    while ((prev = cas (p, old, (expr))) != old)			\
+      old = prev;							\
+    return old;								\
+  }									\
+									\
+  static U								\
+  zacas_##op##_fetch (U *p, U val, int model)				\
+  {									\
+    U old = zacas_fetch_##op (p, val, model);				\
+									\
+    return (expr);							\
+  }
+
+FETCH_OP (add, old + val)
+FETCH_OP (sub, old - val)
+FETCH_OP (and, old & val)
+FETCH_OP (or, old | val)
+FETCH_OP (xor, old ^ val)
+FETCH_OP (nand, ~(old & val))
+
+/* 1 if the double-word atomics use amocas, 0 if they use libatomic's
+   locks, and -1 before the first IFUNC is resolved.  Tests read it through
+   __target_opt_atomic_zacas: a function, so that libatomic.so's resolvers
+   and a program with a copy relocation never see different variables.  */
+#ifdef TARGET_OPT_IFUNC
+static int zacas_state = -1;
+#else
+static int zacas_state = 1;
+#endif
+
+int __attribute__ ((visibility ("default")))
+__target_opt_atomic_zacas (void)
+{
+  return zacas_state;
+}
+
+typedef U load_fn (U *, int);
+typedef void store_fn (U *, U, int);
+typedef U exchange_fn (U *, U, int);
+typedef bool compare_exchange_fn (U *, U *, U, int, int);
+typedef U fetch_op_fn (U *, U, int);
+
+#ifdef TARGET_OPT_IFUNC
+#include "target-opt-hwprobe.h"
+
+/* IFUNC resolvers can run before the stack guard is set up.  */
+static int __attribute__ ((no_stack_protector))
+have_zacas (void)
+{
+  struct riscv_hwprobe pair;
+
+  if (zacas_state >= 0)
+    return zacas_state;
+
+  pair.key = RISCV_HWPROBE_KEY_IMA_EXT_0;
+  pair.value = 0;
+  zacas_state
+    = target_opt_hwprobe (&pair, 1) == 0
+      && pair.key == RISCV_HWPROBE_KEY_IMA_EXT_0
+      && (pair.value & RISCV_HWPROBE_EXT_ZACAS) != 0;
+  return zacas_state;
+}
+
+/* Resolve OP_N to zacas_OP or to libatomic's libat_OP_N_lock.  */
+#define SELECT(op, type)						\
+  extern type PASTE (SIZED (PASTE (libat_, op)), _lock)		\
+    __attribute__ ((visibility ("hidden")));				\
+									\
+  static type * __attribute__ ((no_stack_protector))			\
+  PASTE (select_, op) (void)						\
+  {									\
+    return have_zacas () ? zacas_##op					\
+			 : PASTE (SIZED (PASTE (libat_, op)), _lock);	\
+  }
+#define TARGET(op) __attribute__ ((ifunc ("select_" #op)))
+#else
+#define SELECT(op, type)
+#define TARGET(op) __attribute__ ((alias ("zacas_" #op)))
+#endif
+
+/* __atomic_OP_N is given as an asm label because GCC knows
+   __atomic_load_16 and so on as built-ins with other prototypes.  The
+   libat_ names are hidden in libatomic; keep them that way.  */
+#define QUOTE_(x) #x
+#define QUOTE(x) QUOTE_ (x)
+#define OP(op, type)							\
+  SELECT (op, type##_fn)						\
+									\
+  extern type##_fn PASTE (entry_, op)					\
+    __asm__ (QUOTE (SIZED (PASTE (__atomic_, op)))) TARGET (op);	\
+  extern type##_fn SIZED (PASTE (libat_, op))				\
+    __attribute__ ((visibility ("hidden"))) TARGET (op);
+
+OP (load, load)
+OP (store, store)
+OP (exchange, exchange)
+OP (compare_exchange, compare_exchange)
+OP (fetch_add, fetch_op)
+OP (fetch_sub, fetch_op)
+OP (fetch_and, fetch_op)
+OP (fetch_or, fetch_op)
+OP (fetch_xor, fetch_op)
+OP (fetch_nand, fetch_op)
+OP (add_fetch, fetch_op)
+OP (sub_fetch, fetch_op)
+OP (and_fetch, fetch_op)
+OP (or_fetch, fetch_op)
+OP (xor_fetch, fetch_op)
+OP (nand_fetch, fetch_op)
+
+#endif
@@ -0,0 +1,48 @@
+/* The glibc-hwcaps subdirectories for RISC-V, one per ISA level given to
+   configure with --with-glibc-hwcaps.  This file replaces glibc's generic
+   elf/dl-hwcaps-subdirs.c, which has none, in the overlay made by
+   scripts/make-glibc-hwcaps-overlay; that script also writes
+   dl-hwcaps-levels.h from the level names.
+
+   The dynamic loader searches the subdirectories that are active in the
+   order of _dl_hwcaps_subdirs, most capable level first.  A level is
+   active when riscv_hwprobe reports all of its extensions.  */
+
+#include <dl-hwcaps.h>
+#include "hwprobe.h"
+#include "dl-hwcaps-levels.h"
+
+#if TARGET_OPT_HWCAPS_COUNT > 0
+const char _dl_hwcaps_subdirs[] = TARGET_OPT_HWCAPS_SUBDIRS;
+
+/* The RISCV_HWPROBE_KEY_IMA_EXT_0 bits each level needs, in the order of
+   _dl_hwcaps_subdirs.  */
+static const unsigned long long level_ext0[TARGET_OPT_HWCAPS_COUNT] =
+  TARGET_OPT_HWCAPS_EXT0;
+
+uint32_t
+_dl_hwcaps_subdirs_active (void)
+{
+  struct riscv_hwprobe pair;
+  uint32_t active = 0;
+
+  pair.key = RISCV_HWPROBE_KEY_IMA_EXT_0;
+  pair.value = 0;
+  if (target_opt_hwprobe (&pair, 1) != 0
+      || pair.key != RISCV_HWPROBE_KEY_IMA_EXT_0)
+    return 0;
+
+  for (int i = 0; i < TARGET_OPT_HWCAPS_COUNT; i++)
+    if ((pair.value & level_ext0[i]) == level_ext0[i])
+      active |= 1U << i;
+  return active;
+}
+#else
+const char _dl_hwcaps_subdirs[] = "";
+
+uint32_t
+_dl_hwcaps_subdirs_active (void)
+{
+  return 0;
+}
+#endif
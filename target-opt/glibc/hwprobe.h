@@ -0,0 +1,43 @@
+/* The riscv_hwprobe system call for IFUNC resolvers.  Resolvers run before
+   TLS is set up, so the system call is made directly rather than through
+   glibc, which would set errno.  */
+
+#ifndef TARGET_OPT_HWPROBE_H
+#define TARGET_OPT_HWPROBE_H
+
+#include <asm/hwprobe.h>
+#include <asm/unistd.h>
+
+/* Older kernel headers lack the newer extension bits.  */
+#ifndef RISCV_HWPROBE_EXT_ZACAS
+# define RISCV_HWPROBE_EXT_ZACAS	(1ULL << 34)
+#endif
+#ifndef RISCV_HWPROBE_EXT_ZAWRS
+# define RISCV_HWPROBE_EXT_ZAWRS	(1ULL << 48)
+#endif
+
+/* Fill in the values of the COUNT keys in PAIRS.  Returns 0 on success
+   and a negative error number otherwise, -ENOSYS in particular on kernels
+   without hwprobe.  A key the kernel does not know is set to -1.  */
+static inline long
+target_opt_hwprobe (struct riscv_hwprobe *pairs, long count)
+{
+#ifdef __NR_riscv_hwprobe
+  register long a0 __asm__ ("a0") = (long) pairs;
+  register long a1 __asm__ ("a1") = count;
+  register long a2 __asm__ ("a2") = 0;
+  register long a3 __asm__ ("a3") = 0;
+  register long a4 __asm__ ("a4") = 0;
+  register long a7 __asm__ ("a7") = __NR_riscv_hwprobe;
+
+  __asm__ volatile ("ecall"
+		    : "+r" (a0)
+		    : "r" (a1), "r" (a2), "r" (a3), "r" (a4), "r" (a7)
+		    : "memory");
+  return a0;
+#else
+  return -38;
+#endif
+}
+
+#endif
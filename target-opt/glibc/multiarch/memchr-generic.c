@@ -0,0 +1,10 @@
+/* glibc's generic memchr, as __memchr_generic for the selector in
+   memchr.c.  */
+
+#if IS_IN (libc)
+# define MEMCHR __memchr_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/memchr.c>
@@ -0,0 +1,47 @@
+/* Multiple versions of memchr.  The RVV routine from target-opt/string on
+   a CPU with V, the Zbb one on a CPU with Zbb, and glibc's generic one
+   otherwise.  */
+
+#if IS_IN (libc)
+/* Redefine memchr so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef memchr
+# define memchr __redirect_memchr
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+extern __typeof (__redirect_memchr) __libc_memchr;
+
+extern __typeof (__redirect_memchr) __memchr_rvv attribute_hidden;
+extern __typeof (__redirect_memchr) __memchr_zbb attribute_hidden;
+extern __typeof (__redirect_memchr) __memchr_generic attribute_hidden;
+
+static inline __typeof (__redirect_memchr) *
+select_memchr_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  if (ext & RISCV_HWPROBE_IMA_V)
+    return TARGET_OPT_SELECT (MEMCHR, "rvv", __memchr_rvv);
+  if (ext & RISCV_HWPROBE_EXT_ZBB)
+    return TARGET_OPT_SELECT (MEMCHR, "zbb", __memchr_zbb);
+  return TARGET_OPT_SELECT (MEMCHR, "libc", __memchr_generic);
+}
+
+riscv_libc_ifunc (__libc_memchr, select_memchr_ifunc);
+
+# undef memchr
+strong_alias (__libc_memchr, memchr);
+strong_alias (__libc_memchr, __memchr)
+# ifdef SHARED
+__hidden_ver1 (memchr, __GI_memchr, __redirect_memchr)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memchr);
+# endif
+#else
+# include <string/memchr.c>
+#endif
@@ -0,0 +1,49 @@
+/* Multiple versions of memcpy.  The RVV routine from target-opt/string on
+   a CPU with V, and otherwise glibc's own choice between the generic and
+   the unaligned-access routine.  */
+
+#if IS_IN (libc)
+/* Redefine memcpy so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef memcpy
+# define memcpy __redirect_memcpy
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+extern __typeof (__redirect_memcpy) __libc_memcpy;
+
+extern __typeof (__redirect_memcpy) __memcpy_rvv attribute_hidden;
+extern __typeof (__redirect_memcpy) __memcpy_generic attribute_hidden;
+extern __typeof (__redirect_memcpy) __memcpy_noalignment attribute_hidden;
+
+static inline __typeof (__redirect_memcpy) *
+select_memcpy_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext, perf;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  if (ext & RISCV_HWPROBE_IMA_V)
+    return TARGET_OPT_SELECT (MEMCPY, "rvv", __memcpy_rvv);
+
+  perf = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_CPUPERF_0);
+  if ((perf & RISCV_HWPROBE_MISALIGNED_MASK) == RISCV_HWPROBE_MISALIGNED_FAST)
+    return TARGET_OPT_SELECT (MEMCPY, "libc", __memcpy_noalignment);
+
+  return TARGET_OPT_SELECT (MEMCPY, "libc", __memcpy_generic);
+}
+
+riscv_libc_ifunc (__libc_memcpy, select_memcpy_ifunc);
+
+# undef memcpy
+strong_alias (__libc_memcpy, memcpy);
+# ifdef SHARED
+__hidden_ver1 (memcpy, __GI_memcpy, __redirect_memcpy)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memcpy);
+# endif
+#else
+# include <string/memcpy.c>
+#endif
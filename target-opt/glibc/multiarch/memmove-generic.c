@@ -0,0 +1,10 @@
+/* glibc's generic memmove, as __memmove_generic for the selector in
+   memmove.c.  */
+
+#if IS_IN (libc)
+# define MEMMOVE __memmove_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/memmove.c>
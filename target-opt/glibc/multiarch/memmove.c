@@ -0,0 +1,42 @@
+/* Multiple versions of memmove.  The RVV routine from target-opt/string on
+   a CPU with V, and glibc's generic one otherwise.  */
+
+#if IS_IN (libc)
+/* Redefine memmove so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef memmove
+# define memmove __redirect_memmove
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+extern __typeof (__redirect_memmove) __libc_memmove;
+
+extern __typeof (__redirect_memmove) __memmove_rvv attribute_hidden;
+extern __typeof (__redirect_memmove) __memmove_generic attribute_hidden;
+
+static inline __typeof (__redirect_memmove) *
+select_memmove_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  if (ext & RISCV_HWPROBE_IMA_V)
+    return TARGET_OPT_SELECT (MEMMOVE, "rvv", __memmove_rvv);
+  return TARGET_OPT_SELECT (MEMMOVE, "libc", __memmove_generic);
+}
+
+riscv_libc_ifunc (__libc_memmove, select_memmove_ifunc);
+
+# undef memmove
+strong_alias (__libc_memmove, memmove);
+# ifdef SHARED
+__hidden_ver1 (memmove, __GI_memmove, __redirect_memmove)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memmove);
+# endif
+#else
+# include <string/memmove.c>
+#endif
@@ -0,0 +1,10 @@
+/* glibc's generic memset, as __memset_generic for the selector in
+   memset.c.  */
+
+#if IS_IN (libc)
+# define MEMSET __memset_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/memset.c>
@@ -0,0 +1,91 @@
+/* Multiple versions of memset.  The RVV routine from target-opt/string on
+   a CPU with V, and glibc's generic one otherwise.  On a CPU with Zicboz
+   either is wrapped by __memset_zicboz, which clears the cache blocks of
+   large zero fills with cbo.zero.  */
+
+#if IS_IN (libc)
+/* Redefine memset so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef memset
+# define memset __redirect_memset
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+/* Below this size, or for a non-zero byte, memset is not worth the
+   cbo.zero loop.  */
+# define CBOZ_THRESHOLD	4096
+
+extern __typeof (__redirect_memset) __libc_memset;
+
+extern __typeof (__redirect_memset) __memset_rvv attribute_hidden;
+extern __typeof (__redirect_memset) __memset_generic attribute_hidden;
+
+static __typeof (__redirect_memset) *memset_inner;
+static size_t cboz_block_size;
+
+/* Leaves everything but the whole cache blocks of a large zero fill,
+   including the unaligned head and tail, to memset_inner.  */
+static void *
+__memset_zicboz (void *s, int c, size_t n)
+{
+  unsigned char *p = s;
+  size_t block = cboz_block_size;
+  size_t head;
+
+  if (c != 0 || n < CBOZ_THRESHOLD)
+    return memset_inner (s, c, n);
+
+  head = -(uintptr_t) p & (block - 1);
+  memset_inner (p, 0, head);
+  p += head;
+  n -= head;
+  for (; n >= block; n -= block, p += block)
+    asm volatile (".option push\n\t"
+		  ".option arch, +zicboz\n\t"
+		  "cbo.zero (%0)\n\t"
+		  ".option pop"
+		  : : "r" (p) : "memory");
+  memset_inner (p, 0, n);
+  return s;
+}
+
+static inline __typeof (__redirect_memset) *
+select_memset_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext, block;
+  int zicboz;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  block = target_opt_hwprobe_one (hwprobe_func,
+				  RISCV_HWPROBE_KEY_ZICBOZ_BLOCK_SIZE);
+  zicboz = ((ext & RISCV_HWPROBE_EXT_ZICBOZ)
+	    && block != 0 && (block & (block - 1)) == 0
+	    && block <= CBOZ_THRESHOLD);
+
+  if (ext & RISCV_HWPROBE_IMA_V)
+    memset_inner = TARGET_OPT_SELECT (MEMSET, zicboz ? "rvv+zicboz" : "rvv",
+				      __memset_rvv);
+  else
+    memset_inner = TARGET_OPT_SELECT (MEMSET, zicboz ? "libc+zicboz" : "libc",
+				      __memset_generic);
+  if (!zicboz)
+    return memset_inner;
+  cboz_block_size = block;
+  return __memset_zicboz;
+}
+
+riscv_libc_ifunc (__libc_memset, select_memset_ifunc);
+
+# undef memset
+strong_alias (__libc_memset, memset);
+# ifdef SHARED
+__hidden_ver1 (memset, __GI_memset, __redirect_memset)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memset);
+# endif
+#else
+# include <string/memset.c>
+#endif
@@ -0,0 +1,10 @@
+/* glibc's generic strchr, as __strchr_generic for the selector in
+   strchr.c.  */
+
+#if IS_IN (libc)
+# define STRCHR __strchr_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/strchr.c>
@@ -0,0 +1,47 @@
+/* Multiple versions of strchr.  The RVV routine from target-opt/string on
+   a CPU with V, the Zbb one on a CPU with Zbb, and glibc's generic one
+   otherwise.  */
+
+#if IS_IN (libc)
+/* Redefine strchr so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef strchr
+# define strchr __redirect_strchr
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+extern __typeof (__redirect_strchr) __libc_strchr;
+
+extern __typeof (__redirect_strchr) __strchr_rvv attribute_hidden;
+extern __typeof (__redirect_strchr) __strchr_zbb attribute_hidden;
+extern __typeof (__redirect_strchr) __strchr_generic attribute_hidden;
+
+static inline __typeof (__redirect_strchr) *
+select_strchr_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  if (ext & RISCV_HWPROBE_IMA_V)
+    return TARGET_OPT_SELECT (STRCHR, "rvv", __strchr_rvv);
+  if (ext & RISCV_HWPROBE_EXT_ZBB)
+    return TARGET_OPT_SELECT (STRCHR, "zbb", __strchr_zbb);
+  return TARGET_OPT_SELECT (STRCHR, "libc", __strchr_generic);
+}
+
+riscv_libc_ifunc (__libc_strchr, select_strchr_ifunc);
+
+# undef strchr
+strong_alias (__libc_strchr, strchr);
+weak_alias (__libc_strchr, index)
+# ifdef SHARED
+__hidden_ver1 (strchr, __GI_strchr, __redirect_strchr)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (strchr);
+# endif
+#else
+# include <string/strchr.c>
+#endif
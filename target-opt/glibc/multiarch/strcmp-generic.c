@@ -0,0 +1,10 @@
+/* glibc's generic strcmp, as __strcmp_generic for the selector in
+   strcmp.c.  */
+
+#if IS_IN (libc)
+# define STRCMP __strcmp_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/strcmp.c>
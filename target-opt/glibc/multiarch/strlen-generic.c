@@ -0,0 +1,10 @@
+/* glibc's generic strlen, as __strlen_generic for the selector in
+   strlen.c.  */
+
+#if IS_IN (libc)
+# define STRLEN __strlen_generic
+# undef libc_hidden_builtin_def
+# define libc_hidden_builtin_def(name)
+#endif
+
+#include <string/strlen.c>
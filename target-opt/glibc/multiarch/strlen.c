@@ -0,0 +1,46 @@
+/* Multiple versions of strlen.  The RVV routine from target-opt/string on
+   a CPU with V, the Zbb one on a CPU with Zbb, and glibc's generic one
+   otherwise.  */
+
+#if IS_IN (libc)
+/* Redefine strlen so that the compiler won't complain about the type
+   mismatch with the IFUNC selector in strong_alias, below.  */
+# undef strlen
+# define strlen __redirect_strlen
+# include <stdint.h>
+# include <string.h>
+# include <ifunc-init.h>
+# include <riscv-ifunc.h>
+# include <sys/hwprobe.h>
+# include "target-opt-string.h"
+
+extern __typeof (__redirect_strlen) __libc_strlen;
+
+extern __typeof (__redirect_strlen) __strlen_rvv attribute_hidden;
+extern __typeof (__redirect_strlen) __strlen_zbb attribute_hidden;
+extern __typeof (__redirect_strlen) __strlen_generic attribute_hidden;
+
+static inline __typeof (__redirect_strlen) *
+select_strlen_ifunc (uint64_t dl_hwcap, __riscv_hwprobe_t hwprobe_func)
+{
+  uint64_t ext;
+
+  ext = target_opt_hwprobe_one (hwprobe_func, RISCV_HWPROBE_KEY_IMA_EXT_0);
+  if (ext & RISCV_HWPROBE_IMA_V)
+    return TARGET_OPT_SELECT (STRLEN, "rvv", __strlen_rvv);
+  if (ext & RISCV_HWPROBE_EXT_ZBB)
+    return TARGET_OPT_SELECT (STRLEN, "zbb", __strlen_zbb);
+  return TARGET_OPT_SELECT (STRLEN, "libc", __strlen_generic);
+}
+
+riscv_libc_ifunc (__libc_strlen, select_strlen_ifunc);
+
+# undef strlen
+strong_alias (__libc_strlen, strlen);
+# ifdef SHARED
+__hidden_ver1 (strlen, __GI_strlen, __redirect_strlen)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (strlen);
+# endif
+#else
+# include <string/strlen.c>
+#endif
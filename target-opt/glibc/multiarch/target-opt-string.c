@@ -0,0 +1,29 @@
+/* Report which variant the IFUNC selectors of the target-opt string
+   routines picked, so that tests can check the dispatch.  */
+
+#include <string.h>
+#include "target-opt-string.h"
+
+const char *__target_opt_string_variants[TARGET_OPT_STRING_COUNT];
+
+static const char *const names[TARGET_OPT_STRING_COUNT] =
+{
+  [TARGET_OPT_MEMCPY] = "memcpy",
+  [TARGET_OPT_MEMMOVE] = "memmove",
+  [TARGET_OPT_MEMSET] = "memset",
+  [TARGET_OPT_STRLEN] = "strlen",
+  [TARGET_OPT_STRCMP] = "strcmp",
+  [TARGET_OPT_STRCHR] = "strchr",
+  [TARGET_OPT_MEMCHR] = "memchr",
+};
+
+/* The variant that NAME resolved to, or NULL if it is not dispatched or
+   has not been resolved.  */
+const char *
+__target_opt_string_variant (const char *name)
+{
+  for (int i = 0; i < TARGET_OPT_STRING_COUNT; i++)
+    if (strcmp (name, names[i]) == 0)
+      return __target_opt_string_variants[i];
+  return NULL;
+}
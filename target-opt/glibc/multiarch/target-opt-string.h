@@ -0,0 +1,45 @@
+/* Shared by the IFUNC selectors that dispatch to the routines under
+   target-opt/string.  Copied into glibc's riscv multiarch directory by
+   scripts/make-glibc-string-overlay.  */
+
+#ifndef TARGET_OPT_STRING_H
+#define TARGET_OPT_STRING_H
+
+#include <stdint.h>
+#include <sys/hwprobe.h>
+
+enum
+{
+  TARGET_OPT_MEMCPY,
+  TARGET_OPT_MEMMOVE,
+  TARGET_OPT_MEMSET,
+  TARGET_OPT_STRLEN,
+  TARGET_OPT_STRCMP,
+  TARGET_OPT_STRCHR,
+  TARGET_OPT_MEMCHR,
+  TARGET_OPT_STRING_COUNT
+};
+
+/* The variant each selector picked, "rvv", "zbb" or "libc" for glibc's own
+   routine, for __target_opt_string_variant.  */
+extern const char *__target_opt_string_variants[TARGET_OPT_STRING_COUNT]
+  attribute_hidden;
+
+/* Record that the selector of NAME picked VARIANT, and return FN.  */
+#define TARGET_OPT_SELECT(name, variant, fn)				\
+  (__target_opt_string_variants[TARGET_OPT_##name] = (variant), (fn))
+
+/* The value of KEY from riscv_hwprobe, or 0 if the kernel does not know
+   it.  */
+static inline uint64_t
+target_opt_hwprobe_one (__riscv_hwprobe_t hwprobe_func, int64_t key)
+{
+  struct riscv_hwprobe pair = { .key = key };
+
+  if (hwprobe_func == NULL || hwprobe_func (&pair, 1, 0, NULL, 0) != 0
+      || pair.key != key)
+    return 0;
+  return pair.value;
+}
+
+#endif
@@ -0,0 +1,49 @@
+/* Vector exp, after fdlibm's __ieee754_exp.
+
+   x = n * ln2 + r with |r| <= ln2 / 2, and exp(r) comes from the same
+   rational approximation as fdlibm.  Arguments whose result would not be
+   a normal number, and NaNs, go to the scalar function.  */
+
+#include <math.h>
+#include "vmath.h"
+
+#define RANGE	708.0
+
+static const double
+  invln2 = 1.44269504088896338700e+00,
+  ln2_hi = 6.93147180369123816490e-01,
+  ln2_lo = 1.90821492927058770002e-10,
+  P1 = 1.66666666666666019037e-01,
+  P2 = -2.77777777770155933842e-03,
+  P3 = 6.61375632143793436117e-05,
+  P4 = -1.65339022054652515390e-06,
+  P5 = 4.13813679705723846039e-08;
+
+vfloat64m2_t
+_ZGVrNxv_exp (vfloat64m2_t x)
+{
+  size_t vl = VMATH_VL ();
+  vmask special = voutside (x, -RANGE, RANGE, vl);
+  vint n = vrint (vmulc (x, invln2, vl), vl);
+  vdouble dn = vcvt (n, vl);
+  vdouble hi = vsub (x, vmulc (dn, ln2_hi, vl), vl);
+  vdouble lo = vmulc (dn, ln2_lo, vl);
+  vdouble r = vsub (hi, lo, vl);
+  vdouble z = vmul (r, r, vl);
+  vdouble c = vpoly (z, vdup (P5, vl), P4, vl);
+  vdouble y;
+
+  c = vpoly (z, c, P3, vl);
+  c = vpoly (z, c, P2, vl);
+  c = vpoly (z, c, P1, vl);
+  c = vsub (r, vmul (z, c, vl), vl);
+  /* 1 - ((lo - (r * c) / (2 - c)) - hi)  */
+  y = vdiv (vmul (r, c, vl), vrsubc (c, 2.0, vl), vl);
+  y = vrsubc (vsub (vsub (lo, y, vl), hi, vl), 1.0, vl);
+  return vfallback1 (vscale (y, n, vl), special, exp, x, vl);
+}
+
+VMATH_FLOAT1 (_ZGVrNxv_expf, _ZGVrNxv_exp)
+
+VMATH_ALIAS (_ZGVrNxv_exp, Sleef_expdx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxv_expf, Sleef_expfx_u10rvvm2)
@@ -0,0 +1,61 @@
+/* Vector log, after fdlibm's __ieee754_log.
+
+   x = 2^k * (1 + f) with 1 + f in [sqrt(2)/2, sqrt(2)), and log(1 + f)
+   comes from fdlibm's polynomial in s = f / (2 + f).  Zero, negative,
+   subnormal and non-finite arguments go to the scalar function.  */
+
+#include <math.h>
+#include "vmath.h"
+
+static const double
+  ln2_hi = 6.93147180369123816490e-01,
+  ln2_lo = 1.90821492927058770002e-10,
+  Lg1 = 6.666666666666735130e-01,
+  Lg2 = 3.999999999940941908e-01,
+  Lg3 = 2.857142874366239149e-01,
+  Lg4 = 2.222219843214978396e-01,
+  Lg5 = 1.818357216161805012e-01,
+  Lg6 = 1.531383769920937332e-01,
+  Lg7 = 1.479819860511658591e-01;
+
+vfloat64m2_t
+_ZGVrNxv_log (vfloat64m2_t x)
+{
+  size_t vl = VMATH_VL ();
+  vmask special = vnotnormal (x, vl);
+  vint ix = vbits (x);
+  vint k = __riscv_vsub_vx_i64m2 (__riscv_vsra_vx_i64m2 (ix, 52, vl),
+				  1023, vl);
+  vdouble m = vfrombits (__riscv_vor_vx_i64m2 (
+			   __riscv_vand_vx_i64m2 (ix, 0x000fffffffffffff, vl),
+			   0x3ff0000000000000, vl));
+  vmask big = __riscv_vmfge_vf_f64m2_b32 (m, M_SQRT2, vl);
+  vdouble f, s, z, w, t1, t2, r, hfsq, dk;
+
+  m = vsel (big, m, vmulc (m, 0.5, vl), vl);
+  k = __riscv_vadd_vx_i64m2_mu (big, k, k, 1, vl);
+  f = vsubc (m, 1.0, vl);
+  s = vdiv (f, vaddc (f, 2.0, vl), vl);
+  z = vmul (s, s, vl);
+  w = vmul (z, z, vl);
+  t1 = vpoly (w, vdup (Lg6, vl), Lg4, vl);
+  t1 = vpoly (w, t1, Lg2, vl);
+  t1 = vmul (w, t1, vl);
+  t2 = vpoly (w, vdup (Lg7, vl), Lg5, vl);
+  t2 = vpoly (w, t2, Lg3, vl);
+  t2 = vpoly (w, t2, Lg1, vl);
+  t2 = vmul (z, t2, vl);
+  r = vadd (t2, t1, vl);
+  hfsq = vmul (vmulc (f, 0.5, vl), f, vl);
+  dk = vcvt (k, vl);
+  /* k * ln2_hi - ((hfsq - (s * (hfsq + R) + k * ln2_lo)) - f)  */
+  r = vadd (vmul (s, vadd (hfsq, r, vl), vl), vmulc (dk, ln2_lo, vl), vl);
+  r = vsub (vsub (hfsq, r, vl), f, vl);
+  r = vsub (vmulc (dk, ln2_hi, vl), r, vl);
+  return vfallback1 (r, special, log, x, vl);
+}
+
+VMATH_FLOAT1 (_ZGVrNxv_logf, _ZGVrNxv_log)
+
+VMATH_ALIAS (_ZGVrNxv_log, Sleef_logdx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxv_logf, Sleef_logfx_u10rvvm2)
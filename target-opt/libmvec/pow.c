@@ -0,0 +1,144 @@
+/* Vector pow, after fdlibm's __ieee754_pow.
+
+   log2(x) is computed in extra precision as t1 + t2, multiplied by y in
+   two parts, and 2^(y * log2(x)) is then evaluated as in fdlibm.  Only
+   the common case is done in vector registers: x a positive normal
+   number, y finite and below 2^31 in magnitude, and a normal result.
+   Everything else, including negative x, goes to the scalar function.  */
+
+#include <math.h>
+#include "vmath.h"
+
+static const double
+  bp1 = 1.5,
+  dp_h1 = 5.84962487220764160156e-01,
+  dp_l1 = 1.35003920212974897128e-08,
+  L1 = 5.99999999999994648725e-01,
+  L2 = 4.28571428578550184252e-01,
+  L3 = 3.33333329818377432918e-01,
+  L4 = 2.72728123808534006489e-01,
+  L5 = 2.30660745775561754067e-01,
+  L6 = 2.06975017800338417784e-01,
+  P1 = 1.66666666666666019037e-01,
+  P2 = -2.77777777770155933842e-03,
+  P3 = 6.61375632143793436117e-05,
+  P4 = -1.65339022054652515390e-06,
+  P5 = 4.13813679705723846039e-08,
+  lg2 = 6.93147180559945286227e-01,
+  lg2_h = 6.93147182464599609375e-01,
+  lg2_l = -1.90465429995776804525e-09,
+  cp = 9.61796693925975554329e-01,
+  cp_h = 9.61796700954437255859e-01,
+  cp_l = -7.02846165095275826516e-09;
+
+vfloat64m2_t
+_ZGVrNxvv_pow (vfloat64m2_t x, vfloat64m2_t y)
+{
+  size_t vl = VMATH_VL ();
+  vmask special = __riscv_vmor_mm_b32 (
+		    vnotnormal (x, vl),
+		    voutside (vabs (y, vl), -1.0, 0x1p31, vl), vl);
+  vint bits = vbits (x);
+  vint hx = __riscv_vsra_vx_i64m2 (bits, 32, vl);
+  vint n = __riscv_vsub_vx_i64m2 (__riscv_vsra_vx_i64m2 (hx, 20, vl),
+				  0x3ff, vl);
+  vint j = __riscv_vand_vx_i64m2 (hx, 0x000fffff, vl);
+  vint ix = __riscv_vor_vx_i64m2 (j, 0x3ff00000, vl);
+  vmask kbig = __riscv_vmsge_vx_i64m2_b32 (j, 0xBB67A, vl);
+  vmask k1 = __riscv_vmand_mm_b32 (__riscv_vmsgt_vx_i64m2_b32 (j, 0x3988E, vl),
+				   __riscv_vmnot_m_b32 (kbig, vl), vl);
+  vdouble ax, bp, dp_h, dp_l, u, v, ss, s_h, s_l, s2, r, t_h, t_l;
+  vdouble p_h, p_l, z_h, z_l, t, t1, t2, y1, z, w;
+  vint k;
+
+  /* Move x to [sqrt(3)/2, sqrt(3)) and split off the nearest of 1 and
+     1.5.  */
+  n = __riscv_vadd_vx_i64m2_mu (kbig, n, n, 1, vl);
+  ix = __riscv_vsub_vx_i64m2_mu (kbig, ix, ix, 0x00100000, vl);
+  k = __riscv_vmerge_vxm_i64m2 (__riscv_vmv_v_x_i64m2 (0, vl), 1, k1, vl);
+  ax = vfrombits (__riscv_vor_vv_i64m2 (
+		    __riscv_vsll_vx_i64m2 (ix, 32, vl),
+		    __riscv_vand_vx_i64m2 (bits, 0xffffffff, vl), vl));
+  bp = vsel (k1, vdup (1.0, vl), vdup (bp1, vl), vl);
+  dp_h = vsel (k1, vdup (0.0, vl), vdup (dp_h1, vl), vl);
+  dp_l = vsel (k1, vdup (0.0, vl), vdup (dp_l1, vl), vl);
+
+  /* ss = s_h + s_l = (x - 1) / (x + 1) or (x - 1.5) / (x + 1.5).  */
+  u = vsub (ax, bp, vl);
+  v = vrdivc (vadd (ax, bp, vl), 1.0, vl);
+  ss = vmul (u, v, vl);
+  s_h = vtrunc32 (ss, vl);
+  /* t_h = ax + bp, high part only.  */
+  t_h = vfrombits (__riscv_vsll_vx_i64m2 (
+		     __riscv_vadd_vv_i64m2 (
+		       __riscv_vadd_vx_i64m2 (
+			 __riscv_vor_vx_i64m2 (__riscv_vsra_vx_i64m2 (ix, 1,
+								      vl),
+					       0x20000000, vl),
+			 0x00080000, vl),
+		       __riscv_vsll_vx_i64m2 (k, 18, vl), vl),
+		     32, vl));
+  t_l = vsub (ax, vsub (t_h, bp, vl), vl);
+  s_l = vmul (v, vsub (vsub (u, vmul (s_h, t_h, vl), vl),
+		       vmul (s_h, t_l, vl), vl), vl);
+
+  /* log(ax).  */
+  s2 = vmul (ss, ss, vl);
+  r = vpoly (s2, vdup (L6, vl), L5, vl);
+  r = vpoly (s2, r, L4, vl);
+  r = vpoly (s2, r, L3, vl);
+  r = vpoly (s2, r, L2, vl);
+  r = vpoly (s2, r, L1, vl);
+  r = vmul (vmul (s2, s2, vl), r, vl);
+  r = vadd (r, vmul (s_l, vadd (s_h, ss, vl), vl), vl);
+  s2 = vmul (s_h, s_h, vl);
+  t_h = vtrunc32 (vadd (vaddc (s2, 3.0, vl), r, vl), vl);
+  t_l = vsub (r, vsub (vsubc (t_h, 3.0, vl), s2, vl), vl);
+  /* u + v = ss * (1 + ...).  */
+  u = vmul (s_h, t_h, vl);
+  v = vadd (vmul (s_l, t_h, vl), vmul (t_l, ss, vl), vl);
+  /* 2 / (3 log2) * (ss + ...).  */
+  p_h = vtrunc32 (vadd (u, v, vl), vl);
+  p_l = vsub (v, vsub (p_h, u, vl), vl);
+  z_h = vmulc (p_h, cp_h, vl);
+  z_l = vadd (vadd (vmulc (p_h, cp_l, vl), vmulc (p_l, cp, vl), vl), dp_l,
+	      vl);
+  /* log2(ax) = (ss + ...) * 2 / (3 log2) = n + dp_h + z_h + z_l.  */
+  t = vcvt (n, vl);
+  t1 = vtrunc32 (vadd (vadd (vadd (z_h, z_l, vl), dp_h, vl), t, vl), vl);
+  t2 = vsub (z_l, vsub (vsub (vsub (t1, t, vl), dp_h, vl), z_h, vl), vl);
+
+  /* y * log2(x) = p_h + p_l, with y split in y1 + (y - y1).  */
+  y1 = vtrunc32 (y, vl);
+  p_l = vadd (vmul (vsub (y, y1, vl), t1, vl), vmul (y, t2, vl), vl);
+  p_h = vmul (y1, t1, vl);
+  z = vadd (p_l, p_h, vl);
+  special = __riscv_vmor_mm_b32 (special, voutside (z, -1021.0, 1023.0, vl),
+				 vl);
+
+  /* 2^(p_h + p_l).  */
+  n = vrint (z, vl);
+  p_h = vsub (p_h, vcvt (n, vl), vl);
+  t = vtrunc32 (vadd (p_l, p_h, vl), vl);
+  u = vmulc (t, lg2_h, vl);
+  v = vadd (vmulc (vsub (p_l, vsub (t, p_h, vl), vl), lg2, vl),
+	    vmulc (t, lg2_l, vl), vl);
+  z = vadd (u, v, vl);
+  w = vsub (v, vsub (z, u, vl), vl);
+  t = vmul (z, z, vl);
+  t1 = vpoly (t, vdup (P5, vl), P4, vl);
+  t1 = vpoly (t, t1, P3, vl);
+  t1 = vpoly (t, t1, P2, vl);
+  t1 = vpoly (t, t1, P1, vl);
+  t1 = vsub (z, vmul (t, t1, vl), vl);
+  /* 1 - (((z * t1) / (t1 - 2) - (w + z * w)) - z)  */
+  r = vsub (vdiv (vmul (z, t1, vl), vsubc (t1, 2.0, vl), vl),
+	    vadd (w, vmul (z, w, vl), vl), vl);
+  z = vrsubc (vsub (r, z, vl), 1.0, vl);
+  return vfallback2 (vscale (z, n, vl), special, pow, x, y, vl);
+}
+
+VMATH_FLOAT2 (_ZGVrNxvv_powf, _ZGVrNxvv_pow)
+
+VMATH_ALIAS (_ZGVrNxvv_pow, Sleef_powdx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxvv_powf, Sleef_powfx_u10rvvm2)
@@ -0,0 +1,122 @@
+/* Vector sin and cos, after fdlibm's __ieee754_rem_pio2, __kernel_sin and
+   __kernel_cos.
+
+   The argument is reduced by the nearest multiple n of pi/2 with pi/2
+   split in three parts (118 bits), which is exact enough for |x| < 1e5;
+   larger arguments need the Payne-Hanek reduction and go to the scalar
+   function.  */
+
+#include <math.h>
+#include "vmath.h"
+
+#define RANGE	1e5
+
+static const double
+  invpio2 = 6.36619772367581382433e-01,
+  pio2_1 = 1.57079632673412561417e+00,
+  pio2_2 = 6.07710050630396597660e-11,
+  pio2_2t = 2.02226624879595063154e-21,
+  S1 = -1.66666666666666324348e-01,
+  S2 = 8.33333333332248946124e-03,
+  S3 = -1.98412698298579493134e-04,
+  S4 = 2.75573137070700676789e-06,
+  S5 = -2.50507602534068634195e-08,
+  S6 = 1.58969099521155010221e-10,
+  C1 = 4.16666666666666019037e-02,
+  C2 = -1.38888888888741095749e-03,
+  C3 = 2.48015872894767294178e-05,
+  C4 = -2.75573143513906633035e-07,
+  C5 = 2.08757232129817482790e-09,
+  C6 = -1.13596475577881948265e-11;
+
+/* Reduce x to y0 + y1 in [-pi/4, pi/4] and return the quadrant.  */
+static inline vint
+reduce (vdouble x, vdouble *y0, vdouble *y1, size_t vl)
+{
+  vint n = vrint (vmulc (x, invpio2, vl), vl);
+  vdouble fn = vcvt (n, vl);
+  vdouble t = vsub (x, vmulc (fn, pio2_1, vl), vl);
+  vdouble w = vmulc (fn, pio2_2, vl);
+  vdouble r = vsub (t, w, vl);
+
+  w = vsub (vmulc (fn, pio2_2t, vl), vsub (vsub (t, r, vl), w, vl), vl);
+  *y0 = vsub (r, w, vl);
+  *y1 = vsub (vsub (r, *y0, vl), w, vl);
+  return n;
+}
+
+static inline vdouble
+kernel_sin (vdouble x, vdouble y, size_t vl)
+{
+  vdouble z = vmul (x, x, vl);
+  vdouble v = vmul (z, x, vl);
+  vdouble r = vpoly (z, vdup (S6, vl), S5, vl);
+
+  r = vpoly (z, r, S4, vl);
+  r = vpoly (z, r, S3, vl);
+  r = vpoly (z, r, S2, vl);
+  /* x - ((z * (y / 2 - v * r) - y) - v * S1)  */
+  r = vsub (vmul (z, vsub (vmulc (y, 0.5, vl), vmul (v, r, vl), vl), vl),
+	    y, vl);
+  return vsub (x, vsub (r, vmulc (v, S1, vl), vl), vl);
+}
+
+static inline vdouble
+kernel_cos (vdouble x, vdouble y, size_t vl)
+{
+  vdouble z = vmul (x, x, vl);
+  vdouble r = vpoly (z, vdup (C6, vl), C5, vl);
+  vdouble hz, w;
+
+  r = vpoly (z, r, C4, vl);
+  r = vpoly (z, r, C3, vl);
+  r = vpoly (z, r, C2, vl);
+  r = vpoly (z, r, C1, vl);
+  r = vmul (z, r, vl);
+  hz = vmulc (z, 0.5, vl);
+  w = vrsubc (hz, 1.0, vl);
+  /* w + (((1 - w) - hz) + (z * r - x * y))  */
+  r = vsub (vmul (z, r, vl), vmul (x, y, vl), vl);
+  return vadd (w, vadd (vsub (vrsubc (w, 1.0, vl), hz, vl), r, vl), vl);
+}
+
+/* sin for quadrant n + odd, cos for n + even: the kernel is picked by bit 0
+   and the sign by bit 1.  */
+static inline vdouble
+sincos_quadrant (vdouble x, int odd, double (*scalar) (double))
+{
+  size_t vl = VMATH_VL ();
+  vmask special = voutside (vabs (x, vl), -1.0, RANGE, vl);
+  vdouble y0, y1, s, c, r;
+  vint n = reduce (x, &y0, &y1, vl);
+  vint sign;
+
+  n = __riscv_vadd_vx_i64m2 (n, odd, vl);
+  s = kernel_sin (y0, y1, vl);
+  c = kernel_cos (y0, y1, vl);
+  r = vsel (__riscv_vmsne_vx_i64m2_b32 (__riscv_vand_vx_i64m2 (n, 1, vl),
+					 0, vl), s, c, vl);
+  sign = __riscv_vsll_vx_i64m2 (__riscv_vand_vx_i64m2 (n, 2, vl), 62, vl);
+  r = vfrombits (__riscv_vxor_vv_i64m2 (vbits (r), sign, vl));
+  return vfallback1 (r, special, scalar, x, vl);
+}
+
+vfloat64m2_t
+_ZGVrNxv_sin (vfloat64m2_t x)
+{
+  return sincos_quadrant (x, 0, sin);
+}
+
+vfloat64m2_t
+_ZGVrNxv_cos (vfloat64m2_t x)
+{
+  return sincos_quadrant (x, 1, cos);
+}
+
+VMATH_FLOAT1 (_ZGVrNxv_sinf, _ZGVrNxv_sin)
+VMATH_FLOAT1 (_ZGVrNxv_cosf, _ZGVrNxv_cos)
+
+VMATH_ALIAS (_ZGVrNxv_sin, Sleef_sindx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxv_cos, Sleef_cosdx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxv_sinf, Sleef_sinfx_u10rvvm2)
+VMATH_ALIAS (_ZGVrNxv_cosf, Sleef_cosfx_u10rvvm2)
@@ -0,0 +1,178 @@
+/* Helpers shared by the RISC-V vector math routines.
+
+   Every routine works on a whole LMUL=2 register group, VLMAX elements,
+   like the scalable vector functions the compilers call: vfloat64m2_t for
+   double and vfloat32m2_t for float.  Lanes that the vector code does not
+   handle (NaN, infinities, huge arguments, results near overflow or
+   underflow) are recomputed with the scalar libm function.  */
+
+#ifndef TARGET_OPT_VMATH_H
+#define TARGET_OPT_VMATH_H
+
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+
+typedef vfloat64m2_t vdouble;
+typedef vint64m2_t vint;
+typedef vbool32_t vmask;
+
+#define VMATH_VL()	__riscv_vsetvlmax_e64m2 ()
+
+static inline vdouble vadd (vdouble a, vdouble b, size_t vl)
+{ return __riscv_vfadd_vv_f64m2 (a, b, vl); }
+static inline vdouble vaddc (vdouble a, double b, size_t vl)
+{ return __riscv_vfadd_vf_f64m2 (a, b, vl); }
+static inline vdouble vsub (vdouble a, vdouble b, size_t vl)
+{ return __riscv_vfsub_vv_f64m2 (a, b, vl); }
+static inline vdouble vsubc (vdouble a, double b, size_t vl)
+{ return __riscv_vfsub_vf_f64m2 (a, b, vl); }
+/* b - a.  */
+static inline vdouble vrsubc (vdouble a, double b, size_t vl)
+{ return __riscv_vfrsub_vf_f64m2 (a, b, vl); }
+static inline vdouble vmul (vdouble a, vdouble b, size_t vl)
+{ return __riscv_vfmul_vv_f64m2 (a, b, vl); }
+static inline vdouble vmulc (vdouble a, double b, size_t vl)
+{ return __riscv_vfmul_vf_f64m2 (a, b, vl); }
+static inline vdouble vdiv (vdouble a, vdouble b, size_t vl)
+{ return __riscv_vfdiv_vv_f64m2 (a, b, vl); }
+/* b / a.  */
+static inline vdouble vrdivc (vdouble a, double b, size_t vl)
+{ return __riscv_vfrdiv_vf_f64m2 (a, b, vl); }
+/* a * b + c, for the polynomials.  */
+static inline vdouble vpoly (vdouble a, vdouble b, double c, size_t vl)
+{
+  return __riscv_vfmadd_vv_f64m2 (a, b, __riscv_vfmv_v_f_f64m2 (c, vl), vl);
+}
+static inline vdouble vabs (vdouble a, size_t vl)
+{ return __riscv_vfabs_v_f64m2 (a, vl); }
+static inline vdouble vdup (double a, size_t vl)
+{ return __riscv_vfmv_v_f_f64m2 (a, vl); }
+/* b where m is set, a elsewhere.  */
+static inline vdouble vsel (vmask m, vdouble a, vdouble b, size_t vl)
+{ return __riscv_vmerge_vvm_f64m2 (a, b, m, vl); }
+
+/* Round to the nearest integer, ties to even, as the dynamic rounding mode
+   is left at its default.  */
+static inline vint vrint (vdouble a, size_t vl)
+{ return __riscv_vfcvt_x_f_v_i64m2 (a, vl); }
+static inline vdouble vcvt (vint a, size_t vl)
+{ return __riscv_vfcvt_f_x_v_f64m2 (a, vl); }
+static inline vint vbits (vdouble a)
+{ return __riscv_vreinterpret_v_f64m2_i64m2 (a); }
+static inline vdouble vfrombits (vint a)
+{ return __riscv_vreinterpret_v_i64m2_f64m2 (a); }
+/* a with the low 32 bits of the significand cleared.  */
+static inline vdouble vtrunc32 (vdouble a, size_t vl)
+{
+  return vfrombits (__riscv_vand_vx_i64m2 (vbits (a), -((int64_t) 1 << 32), vl));
+}
+/* a * 2^n for a in [0.5, 2) and a normal result.  */
+static inline vdouble vscale (vdouble a, vint n, size_t vl)
+{
+  return vfrombits (__riscv_vadd_vv_i64m2 (vbits (a),
+					   __riscv_vsll_vx_i64m2 (n, 52, vl),
+					   vl));
+}
+
+/* Lanes for which !(lo < a && a < hi), including NaNs.  */
+static inline vmask voutside (vdouble a, double lo, double hi, size_t vl)
+{
+  vmask in = __riscv_vmand_mm_b32 (__riscv_vmfgt_vf_f64m2_b32 (a, lo, vl),
+				   __riscv_vmflt_vf_f64m2_b32 (a, hi, vl), vl);
+  return __riscv_vmnot_m_b32 (in, vl);
+}
+
+/* Lanes that are not positive normal numbers.  */
+static inline vmask vnotnormal (vdouble a, size_t vl)
+{
+  vmask in = __riscv_vmand_mm_b32 (__riscv_vmfge_vf_f64m2_b32 (a, DBL_MIN, vl),
+				   __riscv_vmfle_vf_f64m2_b32 (a, DBL_MAX, vl),
+				   vl);
+  return __riscv_vmnot_m_b32 (in, vl);
+}
+
+/* Replace the lanes of r selected by special with fn of the inputs.  */
+static inline vdouble
+vfallback1 (vdouble r, vmask special, double (*fn) (double), vdouble x,
+	    size_t vl)
+{
+  double xs[vl], rs[vl];
+  int64_t ms[vl];
+
+  if (__riscv_vcpop_m_b32 (special, vl) == 0)
+    return r;
+  __riscv_vse64_v_f64m2 (xs, x, vl);
+  __riscv_vse64_v_f64m2 (rs, r, vl);
+  __riscv_vse64_v_i64m2 (ms, __riscv_vmerge_vxm_i64m2 (
+			   __riscv_vmv_v_x_i64m2 (0, vl), 1, special, vl), vl);
+  for (size_t i = 0; i < vl; i++)
+    if (ms[i])
+      rs[i] = fn (xs[i]);
+  return __riscv_vle64_v_f64m2 (rs, vl);
+}
+
+static inline vdouble
+vfallback2 (vdouble r, vmask special, double (*fn) (double, double),
+	    vdouble x, vdouble y, size_t vl)
+{
+  double xs[vl], ys[vl], rs[vl];
+  int64_t ms[vl];
+
+  if (__riscv_vcpop_m_b32 (special, vl) == 0)
+    return r;
+  __riscv_vse64_v_f64m2 (xs, x, vl);
+  __riscv_vse64_v_f64m2 (ys, y, vl);
+  __riscv_vse64_v_f64m2 (rs, r, vl);
+  __riscv_vse64_v_i64m2 (ms, __riscv_vmerge_vxm_i64m2 (
+			   __riscv_vmv_v_x_i64m2 (0, vl), 1, special, vl), vl);
+  for (size_t i = 0; i < vl; i++)
+    if (ms[i])
+      rs[i] = fn (xs[i], ys[i]);
+  return __riscv_vle64_v_f64m2 (rs, vl);
+}
+
+/* The exported names: the vector function ABI name, and the SLEEF name
+   that clang -fveclib=SLEEF calls for the same function.  */
+#define VMATH_ALIAS(name, other) \
+  extern __typeof (name) other __attribute__ ((alias (#name)));
+
+/* The float versions widen each half of the vfloat32m2_t to double,
+   which has the same element count as vfloat64m2_t, and round the double
+   result.  */
+#define VMATH_FLOAT1(fname, dname)					\
+  vfloat32m2_t								\
+  fname (vfloat32m2_t x)						\
+  {									\
+    size_t vl = __riscv_vsetvlmax_e32m1 ();				\
+    vfloat32m2_t r = x;							\
+    for (int i = 0; i < 2; i++)						\
+      {									\
+	vdouble d = __riscv_vfwcvt_f_f_v_f64m2 (			\
+		      __riscv_vget_v_f32m2_f32m1 (x, i), vl);		\
+	r = __riscv_vset_v_f32m1_f32m2 (				\
+	      r, i, __riscv_vfncvt_f_f_w_f32m1 (dname (d), vl));	\
+      }									\
+    return r;								\
+  }
+
+#define VMATH_FLOAT2(fname, dname)					\
+  vfloat32m2_t								\
+  fname (vfloat32m2_t x, vfloat32m2_t y)				\
+  {									\
+    size_t vl = __riscv_vsetvlmax_e32m1 ();				\
+    vfloat32m2_t r = x;							\
+    for (int i = 0; i < 2; i++)						\
+      {									\
+	vdouble dx = __riscv_vfwcvt_f_f_v_f64m2 (			\
+		       __riscv_vget_v_f32m2_f32m1 (x, i), vl);		\
+	vdouble dy = __riscv_vfwcvt_f_f_v_f64m2 (			\
+		       __riscv_vget_v_f32m2_f32m1 (y, i), vl);		\
+	r = __riscv_vset_v_f32m1_f32m2 (				\
+	      r, i, __riscv_vfncvt_f_f_w_f32m1 (dname (dx, dy), vl));	\
+      }									\
+    return r;								\
+  }
+
+#endif
@@ -0,0 +1,88 @@
+/* Helpers shared by the assembly routines under target-opt.  */
+
+#ifndef TARGET_OPT_RISCV_ASM_H
+#define TARGET_OPT_RISCV_ASM_H
+
+#if __riscv_xlen == 64
+# define SZREG	8
+# define REG_L	ld
+# define REG_S	sd
+#else
+# define SZREG	4
+# define REG_L	lw
+# define REG_S	sw
+#endif
+
+/* The routines use registers outside of the RV32E/RV64E register file.  */
+#if defined (__riscv_32e) || defined (__riscv_64e) || defined (__riscv_e)
+# define TARGET_OPT_E 1
+#else
+# define TARGET_OPT_E 0
+#endif
+
+/* A variant assembled for a multilib without its extension, to be called
+   through an IFUNC once the CPU is known to have it, is built with
+   -DTARGET_OPT_ENABLE_V or -DTARGET_OPT_ENABLE_ZBB, which enables the
+   extension here; see scripts/make-glibc-string-overlay.  */
+#ifdef __ASSEMBLER__
+# ifdef TARGET_OPT_ENABLE_V
+	.option arch, +v
+# endif
+# ifdef TARGET_OPT_ENABLE_ZBB
+	.option arch, +zbb
+# endif
+#endif
+
+/* Vector routines only need byte elements, so Zve32x is enough.  */
+#if (defined (__riscv_vector) || defined (TARGET_OPT_ENABLE_V)) \
+    && !TARGET_OPT_E
+# define TARGET_OPT_V 1
+#else
+# define TARGET_OPT_V 0
+#endif
+
+/* The word-at-a-time Zbb routines assume little-endian byte order.  */
+#if (defined (__riscv_zbb) || defined (TARGET_OPT_ENABLE_ZBB)) \
+    && !TARGET_OPT_E \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+# define TARGET_OPT_ZBB 1
+#else
+# define TARGET_OPT_ZBB 0
+#endif
+
+/* The scalar memcpy and memset are only built on request, for C libraries
+   without RISC-V assembly routines of their own (musl).  Their misaligned
+   copy assumes little-endian byte order.  */
+#if defined (TARGET_OPT_WANT_SCALAR) && !TARGET_OPT_E \
+    && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+# define TARGET_OPT_SCALAR 1
+#else
+# define TARGET_OPT_SCALAR 0
+#endif
+
+/* Prefetch distance for large copies, a multiple of 32 as the
+   prefetch.[rw] offset requires.  */
+#define PREFETCH_DISTANCE	512
+#define PREFETCH_THRESHOLD	4096
+
+/* Built with -DTARGET_OPT_VARIANT=rvv, memcpy is defined as __memcpy_rvv
+   and so on, for use behind an IFUNC resolver.  */
+#ifdef TARGET_OPT_VARIANT
+# define TARGET_OPT_NAME(name)	TARGET_OPT_NAME1 (name, TARGET_OPT_VARIANT)
+# define TARGET_OPT_NAME1(name, variant) TARGET_OPT_NAME2 (name, variant)
+# define TARGET_OPT_NAME2(name, variant) __##name##_##variant
+#else
+# define TARGET_OPT_NAME(name)	name
+#endif
+
+#define ENTRY(name)		\
+	.text;			\
+	.globl TARGET_OPT_NAME (name);		\
+	.type TARGET_OPT_NAME (name), @function;	\
+	.p2align 2;		\
+TARGET_OPT_NAME (name):
+
+#define END(name)		\
+	.size TARGET_OPT_NAME (name), . - TARGET_OPT_NAME (name)
+
+#endif
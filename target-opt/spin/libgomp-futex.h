@@ -0,0 +1,73 @@
+/* libgomp's futex.h for RISC-V Linux, put in place of config/linux/futex.h
+   by scripts/make-spin-overlay.  It is the generic one, renamed to
+   futex-generic.h, with cpu_relax stalling the hart instead of being a bare
+   compiler barrier, so that threads spinning at barriers and locks let the
+   other harts of the core run and draw less power.
+
+   On a CPU for which riscv_hwprobe reports Zawrs, cpu_relax stalls in
+   wrs.sto, and do_spin in wait.h, which the overlay makes call
+   cpu_relax_on with the address it polls, does so holding a reservation
+   on that address, so that the store it waits for ends the stall early.
+   wrs.sto rather than wrs.nto keeps every iteration of the spin bounded,
+   so GOMP_SPINCOUNT still bounds the spin before the futex wait.
+   Otherwise both issue the Zihintpause pause hint, a FENCE that orders
+   nothing and so a no-op on cores without Zihintpause.  The instructions
+   are written with .insn so that they assemble for any march.  */
+
+#define cpu_relax target_opt_generic_cpu_relax
+#include "futex-generic.h"
+#undef cpu_relax
+
+#include "target-opt-hwprobe.h"
+
+#define TARGET_OPT_PAUSE	".insn i 0x0f, 0, x0, x0, 0x010"
+#define TARGET_OPT_WRS_STO	".insn i 0x73, 0, x0, x0, 0x01d"
+
+/* -1 until the first spin, then 1 if riscv_hwprobe reports Zawrs and 0
+   if not.  Weak, so that the definitions in libgomp's objects are one; the
+   OpenMP benchmark reads it to report which way the runtime spins.  */
+int __target_opt_gomp_zawrs __attribute__ ((weak, visibility ("default")))
+  = -1;
+
+static inline int
+target_opt_have_zawrs (void)
+{
+  int z = __atomic_load_n (&__target_opt_gomp_zawrs, __ATOMIC_RELAXED);
+
+  if (__builtin_expect (z < 0, 0))
+    {
+      struct riscv_hwprobe pair = { .key = RISCV_HWPROBE_KEY_IMA_EXT_0 };
+
+      z = (target_opt_hwprobe (&pair, 1) == 0
+	   && pair.key == RISCV_HWPROBE_KEY_IMA_EXT_0
+	   && (pair.value & RISCV_HWPROBE_EXT_ZAWRS) != 0);
+      __atomic_store_n (&__target_opt_gomp_zawrs, z, __ATOMIC_RELAXED);
+    }
+  return z;
+}
+
+/* Wait a little for *ADDR to change from VAL.  */
+static inline void
+cpu_relax_on (int *addr, int val)
+{
+  int v;
+
+  if (!target_opt_have_zawrs ())
+    {
+      __asm volatile (TARGET_OPT_PAUSE : : : "memory");
+      return;
+    }
+  __asm volatile ("lr.w %0, (%1)" : "=r" (v) : "r" (addr) : "memory");
+  if (v == val)
+    __asm volatile (TARGET_OPT_WRS_STO : : : "memory");
+}
+
+/* Wait a little.  Nothing else stores to the reservation taken on a local,
+   so wrs.sto then runs to its timeout.  */
+static inline void
+cpu_relax (void)
+{
+  int dummy = 0;
+
+  cpu_relax_on (&dummy, 0);
+}
@@ -0,0 +1,36 @@
+#elif defined __riscv
+      // Added by scripts/make-spin-overlay.  Stall for the short timeout
+      // of Zawrs wrs.sto, holding a reservation on a local that nothing
+      // else stores to, where riscv_hwprobe reports Zawrs, and issue the
+      // Zihintpause pause hint otherwise.
+      static int __zawrs = -1;
+      int __z = __atomic_load_n(&__zawrs, __ATOMIC_RELAXED);
+      if (__builtin_expect(__z < 0, 0))
+	{
+	  // RISCV_HWPROBE_KEY_IMA_EXT_0 through __NR_riscv_hwprobe; the
+	  // system call is made directly so that errno is left alone.
+	  long long __pair[2] = { 4, 0 };
+	  register long __a0 __asm__("a0") = (long) __pair;
+	  register long __a1 __asm__("a1") = 1;
+	  register long __a2 __asm__("a2") = 0;
+	  register long __a3 __asm__("a3") = 0;
+	  register long __a4 __asm__("a4") = 0;
+	  register long __a7 __asm__("a7") = 258;
+	  __asm__ __volatile__("ecall"
+			       : "+r"(__a0)
+			       : "r"(__a1), "r"(__a2), "r"(__a3), "r"(__a4),
+				 "r"(__a7)
+			       : "memory");
+	  // RISCV_HWPROBE_EXT_ZAWRS.
+	  __z = __a0 == 0 && __pair[0] == 4 && ((__pair[1] >> 48) & 1);
+	  __atomic_store_n(&__zawrs, __z, __ATOMIC_RELAXED);
+	}
+      if (__z)
+	{
+	  int __dummy = 0, __v;
+	  __asm__ __volatile__("lr.w %0, (%1)\n\t"
+			       ".insn i 0x73, 0, x0, x0, 0x01d"
+			       : "=r"(__v) : "r"(&__dummy) : "memory");
+	}
+      else
+	__asm__ __volatile__(".insn i 0x0f, 0, x0, x0, 0x010");
@@ -0,0 +1,91 @@
+/* Contention test for the double-word atomics of libatomic: 16-byte ones
+   on RV64 and 8-byte ones on RV32, which GCC calls libatomic for.
+
+   THREADS threads update one shared {counter, tag} pair, the way a
+   lock-free queue updates a pointer and its ABA tag: each iteration bumps
+   both halves with a compare-and-exchange loop and then adds to the pair
+   with fetch-and-add.  A lost update leaves the halves different from the
+   expected totals.  Prints PASS or FAIL, followed by the time per
+   operation and, with the libatomic built by this toolchain, an
+   "atomics: amocas" or "atomics: lock" line telling which implementation
+   its IFUNCs picked.  */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define THREADS 4
+#define ITERS 20000
+
+#if __riscv_xlen == 64 || !defined (__riscv_xlen)
+typedef unsigned __int128 pair_t;
+#else
+typedef uint64_t pair_t;
+#endif
+#define HALF_BITS (sizeof (pair_t) * 4)
+#define ONE_EACH (((pair_t) 1 << HALF_BITS) | 1)
+
+/* Which way libatomic's double-word IFUNCs were resolved, see
+   target-opt/atomic/zacas.c.  */
+extern int __target_opt_atomic_zacas (void) __attribute__ ((weak));
+
+static pair_t shared;
+
+static void *
+worker (void *arg)
+{
+  (void) arg;
+  for (int i = 0; i < ITERS; i++)
+    {
+      pair_t old = __atomic_load_n (&shared, __ATOMIC_RELAXED);
+
+      while (!__atomic_compare_exchange_n (&shared, &old, old + ONE_EACH,
+					   0, __ATOMIC_ACQ_REL,
+					   __ATOMIC_RELAXED))
+	;
+      __atomic_fetch_add (&shared, ONE_EACH, __ATOMIC_ACQ_REL);
+    }
+  return NULL;
+}
+
+int
+main (void)
+{
+  pthread_t threads[THREADS];
+  struct timespec t0, t1;
+  pair_t expected = (pair_t) 2 * THREADS * ITERS;
+  pair_t result;
+  double ns;
+
+  clock_gettime (CLOCK_MONOTONIC, &t0);
+  for (int t = 0; t < THREADS; t++)
+    pthread_create (&threads[t], NULL, worker, NULL);
+  for (int t = 0; t < THREADS; t++)
+    pthread_join (threads[t], NULL);
+  clock_gettime (CLOCK_MONOTONIC, &t1);
+
+  result = __atomic_load_n (&shared, __ATOMIC_SEQ_CST);
+  expected |= expected << HALF_BITS;
+  if (result == expected)
+    printf ("PASS: %d-byte atomics with %d threads\n",
+	    (int) sizeof (pair_t), THREADS);
+  else
+    printf ("FAIL: %d-byte atomics with %d threads, counter %llu, tag %llu,"
+	    " expected %llu\n", (int) sizeof (pair_t), THREADS,
+	    (unsigned long long) (uint32_t) result,
+	    (unsigned long long) (uint32_t) (result >> HALF_BITS),
+	    (unsigned long long) (2 * THREADS * ITERS));
+
+  ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+  printf ("%d-byte atomics: %.1f ns/operation\n", (int) sizeof (pair_t),
+	  ns / (2.0 * THREADS * ITERS));
+  if (__target_opt_atomic_zacas)
+    {
+      int zacas = __target_opt_atomic_zacas ();
+
+      printf ("atomics: %s\n", zacas < 0 ? "none"
+	      : zacas ? "amocas" : "lock");
+    }
+  return 0;
+}
@@ -0,0 +1,163 @@
+# Helpers shared by the toolchain benchmarks under test/benchmarks.
+
+import json
+import os
+import re
+import subprocess
+import time
+
+
+class Result:
+    def __init__(self, wall, maxrss, returncode, output):
+        self.wall = wall            # seconds
+        self.maxrss = maxrss        # KiB, largest process in the tree
+        self.returncode = returncode
+        self.output = output        # stdout and stderr
+
+
+def run(cmd, cwd=None, env=None):
+    """ Run cmd and measure its wall time and peak RSS.
+
+    The RSS reported by wait4 covers the process and all the children it
+    waited for, so this also measures e.g. cc1 under the gcc driver.
+    """
+    start = time.monotonic()
+    p = subprocess.Popen(cmd, cwd=cwd, env=env, stdout=subprocess.PIPE,
+                         stderr=subprocess.STDOUT)
+    output = p.stdout.read().decode(errors='replace')
+    _, status, rusage = os.wait4(p.pid, 0)
+    wall = time.monotonic() - start
+    p.returncode = os.waitstatus_to_exitcode(status)
+    return Result(wall, rusage.ru_maxrss, p.returncode, output)
+
+
+def run_best(cmd, repeat, cwd=None, env=None):
+    """ Run cmd repeat times, returning the fastest run, or the first
+    failing one.
+    """
+    best = None
+    for _ in range(repeat):
+        r = run(cmd, cwd, env)
+        if r.returncode != 0:
+            return r
+        if best is None or r.wall < best.wall:
+            best = r
+    return best
+
+
+def preload_env(lib, env=None):
+    """ Return a copy of env, or of the environment, with lib added to
+    LD_PRELOAD, e.g. to run a compiler with another malloc.
+    """
+    env = dict(env if env is not None else os.environ)
+    env['LD_PRELOAD'] = ' '.join(filter(None, [env.get('LD_PRELOAD'), lib]))
+    return env
+
+
+def preload_delta(key, lib, base, preloaded):
+    """ Return a PASS line comparing the run with lib preloaded to the
+    plain one.  It is only reported, not gated.
+    """
+    return 'PASS: %s with %s: wall %s (%s), peak RSS %s (%s)' \
+        % (key, os.path.basename(lib),
+           fmt_seconds(preloaded.wall), change(preloaded.wall, base.wall),
+           fmt_kib(preloaded.maxrss), change(preloaded.maxrss, base.maxrss))
+
+
+_gcc_time_re = re.compile(r'^ (.*\S)\s*:(.*)$')
+_gcc_time_val_re = re.compile(r'([\d.]+)\s*\(\s*[\d.]+%\)')
+_llvm_time_re = re.compile(r'^\s+((?:[\d.]+ \(\s*[\d.]+%\)\s+)+)(\S.*)$')
+
+
+def parse_time_report(text):
+    """ Parse the -ftime-report output of GCC or Clang into a dict of
+    pass name -> wall time in seconds.  Totals and GCC's phase summaries
+    are dropped.
+    """
+    passes = dict()
+    for l in text.splitlines():
+        m = _gcc_time_re.match(l)
+        if m:
+            name = m.group(1)
+            vals = _gcc_time_val_re.findall(m.group(2))
+            if len(vals) < 3 or name.startswith('phase ') \
+               or name == 'TOTAL':
+                continue
+            passes[name] = passes.get(name, 0.0) + float(vals[2])
+            continue
+        m = _llvm_time_re.match(l)
+        if m:
+            name = m.group(2).strip()
+            if name == 'Total':
+                continue
+            vals = _gcc_time_val_re.findall(m.group(1))
+            passes[name] = passes.get(name, 0.0) + float(vals[-1])
+    return passes
+
+
+def top_passes(passes, count):
+    return sorted(passes.items(), key=lambda x: x[1], reverse=True)[:count]
+
+
+def load_baseline(path):
+    if not path or not os.path.exists(path):
+        return dict()
+    with open(path) as f:
+        return json.load(f)
+
+
+def save_baseline(path, baseline):
+    if not path:
+        return
+    tmp = path + '.tmp'
+    with open(tmp, 'w') as f:
+        json.dump(baseline, f, indent=2, sort_keys=True)
+        f.write('\n')
+    os.replace(tmp, path)
+
+
+def regressed(value, base, tolerance):
+    """ True if value is more than tolerance percent above base. """
+    return value > base * (1 + tolerance / 100.0)
+
+
+def change(value, base):
+    if base == 0:
+        return '  n/a'
+    return '%+5.1f%%' % ((value - base) * 100.0 / base)
+
+
+def fmt_seconds(seconds):
+    return '%.2fs' % seconds
+
+
+def fmt_kib(kib):
+    return '%.1f MiB' % (kib / 1024.0)
+
+
+def fmt_bytes(size):
+    return '%d bytes' % size
+
+
+def gate(baseline, key, metrics):
+    """ Compare metrics, a list of (name, value, tolerance, formatter),
+    against baseline[key] and return a PASS/FAIL line for the report.
+    A key missing from the baseline is recorded and passes.
+    """
+    base = baseline.get(key)
+    if base is None:
+        baseline[key] = dict((name, value) for name, value, _, _ in metrics)
+        return 'PASS: %s %s (new baseline)' \
+            % (key, ', '.join('%s %s' % (name, fmt(value))
+                              for name, value, _, fmt in metrics))
+    status = 'PASS'
+    desc = []
+    for name, value, tolerance, fmt in metrics:
+        if name not in base:
+            base[name] = value
+        if regressed(value, base[name], tolerance):
+            status = 'FAIL'
+        desc.append('%s %s (baseline %s, %s)'
+                    % (name, fmt(value), fmt(base[name]),
+                       change(value, base[name])))
+    return '%s: %s %s' % (status, key, ', '.join(desc))
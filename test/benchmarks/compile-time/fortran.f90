@@ -0,0 +1,180 @@
+! Fortran translation unit for the compile-time benchmark.
+!
+! Array expressions, derived types, generic interfaces and nested loops
+! keep the Fortran front end, the scalarizer and the loop optimizers busy.
+
+module bench_kinds
+  implicit none
+  integer, parameter :: sp = selected_real_kind(6)
+  integer, parameter :: dp = selected_real_kind(15)
+end module bench_kinds
+
+module bench_fields
+  use bench_kinds
+  implicit none
+
+  type :: field
+    real(dp), allocatable :: u(:,:,:), v(:,:,:), w(:,:,:)
+    real(dp), allocatable :: p(:,:,:), t(:,:,:)
+    integer :: nx = 0, ny = 0, nz = 0
+  end type field
+
+  interface norm
+    module procedure norm_sp, norm_dp, norm_field
+  end interface norm
+
+  interface axpy
+    module procedure axpy_sp, axpy_dp
+  end interface axpy
+
+contains
+
+  subroutine field_init(f, nx, ny, nz)
+    type(field), intent(out) :: f
+    integer, intent(in) :: nx, ny, nz
+    integer :: i, j, k
+    f%nx = nx; f%ny = ny; f%nz = nz
+    allocate(f%u(nx,ny,nz), f%v(nx,ny,nz), f%w(nx,ny,nz))
+    allocate(f%p(nx,ny,nz), f%t(nx,ny,nz))
+    do k = 1, nz
+      do j = 1, ny
+        do i = 1, nx
+          f%u(i,j,k) = sin(real(i, dp)) * cos(real(j, dp))
+          f%v(i,j,k) = cos(real(i, dp)) * sin(real(k, dp))
+          f%w(i,j,k) = real(i + j + k, dp) / real(nx + ny + nz, dp)
+        end do
+      end do
+    end do
+    f%p = 0.0_dp
+    f%t = 300.0_dp
+  end subroutine field_init
+
+  pure real(sp) function norm_sp(x)
+    real(sp), intent(in) :: x(:)
+    norm_sp = sqrt(sum(x * x))
+  end function norm_sp
+
+  pure real(dp) function norm_dp(x)
+    real(dp), intent(in) :: x(:)
+    norm_dp = sqrt(sum(x * x))
+  end function norm_dp
+
+  real(dp) function norm_field(f)
+    type(field), intent(in) :: f
+    norm_field = sqrt(sum(f%u**2 + f%v**2 + f%w**2))
+  end function norm_field
+
+  pure subroutine axpy_sp(a, x, y)
+    real(sp), intent(in) :: a, x(:)
+    real(sp), intent(inout) :: y(:)
+    y = y + a * x
+  end subroutine axpy_sp
+
+  pure subroutine axpy_dp(a, x, y)
+    real(dp), intent(in) :: a, x(:)
+    real(dp), intent(inout) :: y(:)
+    y = y + a * x
+  end subroutine axpy_dp
+
+  elemental real(dp) function limiter(r)
+    real(dp), intent(in) :: r
+    limiter = max(0.0_dp, min(2.0_dp * r, 1.0_dp), min(r, 2.0_dp))
+  end function limiter
+
+  subroutine advect(f, dt)
+    type(field), intent(inout) :: f
+    real(dp), intent(in) :: dt
+    real(dp), allocatable :: flux(:,:,:), r(:,:,:)
+    integer :: nx, ny, nz
+    nx = f%nx; ny = f%ny; nz = f%nz
+    allocate(flux(nx,ny,nz), r(nx,ny,nz))
+    r = 0.0_dp
+    where (abs(f%t(3:nx,:,:) - f%t(2:nx-1,:,:)) > 1.0e-12_dp)
+      r(2:nx-1,:,:) = (f%t(2:nx-1,:,:) - f%t(1:nx-2,:,:)) &
+                    / (f%t(3:nx,:,:) - f%t(2:nx-1,:,:))
+    end where
+    flux = f%u * f%t * limiter(r)
+    f%t(2:nx,:,:) = f%t(2:nx,:,:) - dt * (flux(2:nx,:,:) - flux(1:nx-1,:,:))
+    flux = f%v * f%t
+    f%t(:,2:ny,:) = f%t(:,2:ny,:) - dt * (flux(:,2:ny,:) - flux(:,1:ny-1,:))
+    flux = f%w * f%t
+    f%t(:,:,2:nz) = f%t(:,:,2:nz) - dt * (flux(:,:,2:nz) - flux(:,:,1:nz-1))
+  end subroutine advect
+
+  subroutine pressure_solve(f, iters)
+    type(field), intent(inout) :: f
+    integer, intent(in) :: iters
+    real(dp), allocatable :: rhs(:,:,:), pn(:,:,:)
+    integer :: it, i, j, k, nx, ny, nz
+    nx = f%nx; ny = f%ny; nz = f%nz
+    allocate(rhs(nx,ny,nz), pn(nx,ny,nz))
+    rhs = 0.0_dp
+    rhs(2:nx-1,2:ny-1,2:nz-1) = &
+        (f%u(3:nx,2:ny-1,2:nz-1) - f%u(1:nx-2,2:ny-1,2:nz-1)) &
+      + (f%v(2:nx-1,3:ny,2:nz-1) - f%v(2:nx-1,1:ny-2,2:nz-1)) &
+      + (f%w(2:nx-1,2:ny-1,3:nz) - f%w(2:nx-1,2:ny-1,1:nz-2))
+    do it = 1, iters
+      pn = f%p
+      do concurrent (k = 2:nz-1, j = 2:ny-1, i = 2:nx-1)
+        f%p(i,j,k) = (pn(i+1,j,k) + pn(i-1,j,k) + pn(i,j+1,k) &
+                    + pn(i,j-1,k) + pn(i,j,k+1) + pn(i,j,k-1) &
+                    - rhs(i,j,k)) / 6.0_dp
+      end do
+    end do
+    f%u(2:nx-1,:,:) = f%u(2:nx-1,:,:) - 0.5_dp * (f%p(3:nx,:,:) - f%p(1:nx-2,:,:))
+    f%v(:,2:ny-1,:) = f%v(:,2:ny-1,:) - 0.5_dp * (f%p(:,3:ny,:) - f%p(:,1:ny-2,:))
+    f%w(:,:,2:nz-1) = f%w(:,:,2:nz-1) - 0.5_dp * (f%p(:,:,3:nz) - f%p(:,:,1:nz-2))
+  end subroutine pressure_solve
+
+  subroutine matmul_blocked(a, b, c, bs)
+    real(dp), intent(in) :: a(:,:), b(:,:)
+    real(dp), intent(out) :: c(:,:)
+    integer, intent(in) :: bs
+    integer :: i, j, k, ii, jj, kk, n, m, l
+    n = size(a, 1); m = size(b, 2); l = size(a, 2)
+    c = 0.0_dp
+    do jj = 1, m, bs
+      do kk = 1, l, bs
+        do ii = 1, n, bs
+          do j = jj, min(jj + bs - 1, m)
+            do k = kk, min(kk + bs - 1, l)
+              do i = ii, min(ii + bs - 1, n)
+                c(i,j) = c(i,j) + a(i,k) * b(k,j)
+              end do
+            end do
+          end do
+        end do
+      end do
+    end do
+  end subroutine matmul_blocked
+
+end module bench_fields
+
+subroutine bench_fortran(n, result)
+  use bench_kinds
+  use bench_fields
+  implicit none
+  integer, intent(in) :: n
+  real(dp), intent(out) :: result
+  type(field) :: f
+  real(dp), allocatable :: a(:,:), b(:,:), c(:,:), x(:), y(:)
+  real(sp), allocatable :: xs(:), ys(:)
+  integer :: step
+
+  call field_init(f, n, n, n)
+  do step = 1, 10
+    call advect(f, 0.01_dp)
+    call pressure_solve(f, 20)
+  end do
+
+  allocate(a(n,n), b(n,n), c(n,n), x(n), y(n), xs(n), ys(n))
+  call random_number(a)
+  call random_number(b)
+  call matmul_blocked(a, b, c, 16)
+  x = c(:,1); y = c(1,:)
+  xs = real(x, sp); ys = real(y, sp)
+  call axpy(2.0_dp, x, y)
+  call axpy(2.0_sp, xs, ys)
+
+  result = norm(f) + norm(y) + real(norm(ys), dp) + sum(matmul(a, b) - c)
+end subroutine bench_fortran
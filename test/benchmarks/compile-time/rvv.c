@@ -0,0 +1,189 @@
+/* Vector-intrinsic-heavy translation unit for the compile-time benchmark.
+
+   Instantiates a set of strip-mined kernels for every integer and
+   floating-point SEW/LMUL combination, which stresses the RVV intrinsic
+   front end, vsetvl insertion and register allocation of vector register
+   groups.  Needs a compiler with the v1.0 (__riscv_*) intrinsics.  */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <riscv_vector.h>
+
+#define INT_KERNELS(SEW, LMUL, MB)					\
+void									\
+vadd_i##SEW##LMUL (int##SEW##_t *d, const int##SEW##_t *a,		\
+		   const int##SEW##_t *b, size_t n)			\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl, b += vl, d += vl)		\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vint##SEW##LMUL##_t va = __riscv_vle##SEW##_v_i##SEW##LMUL (a, vl); \
+      vint##SEW##LMUL##_t vb = __riscv_vle##SEW##_v_i##SEW##LMUL (b, vl); \
+      __riscv_vse##SEW##_v_i##SEW##LMUL (d,				\
+	__riscv_vadd_vv_i##SEW##LMUL (va, vb, vl), vl);			\
+    }									\
+}									\
+									\
+int##SEW##_t								\
+vdot_i##SEW##LMUL (const int##SEW##_t *a, const int##SEW##_t *b,	\
+		   size_t n)						\
+{									\
+  vint##SEW##m1_t acc = __riscv_vmv_s_x_i##SEW##m1 (0, 1);		\
+  for (size_t vl; n > 0; n -= vl, a += vl, b += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vint##SEW##LMUL##_t va = __riscv_vle##SEW##_v_i##SEW##LMUL (a, vl); \
+      vint##SEW##LMUL##_t vb = __riscv_vle##SEW##_v_i##SEW##LMUL (b, vl); \
+      vint##SEW##LMUL##_t vp = __riscv_vmul_vv_i##SEW##LMUL (va, vb, vl); \
+      acc = __riscv_vredsum_vs_i##SEW##LMUL##_i##SEW##m1 (vp, acc, vl);	\
+    }									\
+  return __riscv_vmv_x_s_i##SEW##m1_i##SEW (acc);			\
+}									\
+									\
+void									\
+vclamp_i##SEW##LMUL (int##SEW##_t *d, const int##SEW##_t *a,		\
+		     int##SEW##_t lo, int##SEW##_t hi, size_t n)	\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl, d += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vint##SEW##LMUL##_t va = __riscv_vle##SEW##_v_i##SEW##LMUL (a, vl); \
+      vbool##MB##_t below = __riscv_vmslt_vx_i##SEW##LMUL##_b##MB (va, lo, vl); \
+      vbool##MB##_t above = __riscv_vmsgt_vx_i##SEW##LMUL##_b##MB (va, hi, vl); \
+      vint##SEW##LMUL##_t vlo = __riscv_vmv_v_x_i##SEW##LMUL (lo, vl);	\
+      vint##SEW##LMUL##_t vhi = __riscv_vmv_v_x_i##SEW##LMUL (hi, vl);	\
+      va = __riscv_vmerge_vvm_i##SEW##LMUL (va, vlo, below, vl);	\
+      va = __riscv_vmerge_vvm_i##SEW##LMUL (va, vhi, above, vl);	\
+      __riscv_vse##SEW##_v_i##SEW##LMUL (d, va, vl);			\
+    }									\
+}									\
+									\
+void									\
+vpoly_i##SEW##LMUL (int##SEW##_t *d, const int##SEW##_t *a,		\
+		    const int##SEW##_t *c, size_t n)			\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl, d += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vint##SEW##LMUL##_t x = __riscv_vle##SEW##_v_i##SEW##LMUL (a, vl); \
+      vint##SEW##LMUL##_t r = __riscv_vmv_v_x_i##SEW##LMUL (c[0], vl);	\
+      r = __riscv_vmacc_vx_i##SEW##LMUL (r, c[1], x, vl);		\
+      vint##SEW##LMUL##_t x2 = __riscv_vmul_vv_i##SEW##LMUL (x, x, vl);	\
+      r = __riscv_vmacc_vx_i##SEW##LMUL (r, c[2], x2, vl);		\
+      vint##SEW##LMUL##_t x3 = __riscv_vmul_vv_i##SEW##LMUL (x2, x, vl); \
+      r = __riscv_vmacc_vx_i##SEW##LMUL (r, c[3], x3, vl);		\
+      r = __riscv_vmax_vv_i##SEW##LMUL (r, x, vl);			\
+      r = __riscv_vsra_vx_i##SEW##LMUL (r, 1, vl);			\
+      __riscv_vse##SEW##_v_i##SEW##LMUL (d, r, vl);			\
+    }									\
+}									\
+									\
+void									\
+vgather_i##SEW##LMUL (int##SEW##_t *d, const int##SEW##_t *a,		\
+		      ptrdiff_t stride, size_t n)			\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl * stride, d += vl)		\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vint##SEW##LMUL##_t va						\
+	= __riscv_vlse##SEW##_v_i##SEW##LMUL (a, stride * sizeof (*a), vl); \
+      __riscv_vse##SEW##_v_i##SEW##LMUL (d,				\
+	__riscv_vslidedown_vx_i##SEW##LMUL (va, 1, vl), vl);		\
+    }									\
+}
+
+#define FLOAT_KERNELS(SEW, LMUL, MB)					\
+void									\
+vaxpy_f##SEW##LMUL (bench_f##SEW *y, const bench_f##SEW *x,		\
+		    bench_f##SEW a, size_t n)				\
+{									\
+  for (size_t vl; n > 0; n -= vl, x += vl, y += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vfloat##SEW##LMUL##_t vx = __riscv_vle##SEW##_v_f##SEW##LMUL (x, vl); \
+      vfloat##SEW##LMUL##_t vy = __riscv_vle##SEW##_v_f##SEW##LMUL (y, vl); \
+      vy = __riscv_vfmacc_vf_f##SEW##LMUL (vy, a, vx, vl);		\
+      __riscv_vse##SEW##_v_f##SEW##LMUL (y, vy, vl);			\
+    }									\
+}									\
+									\
+bench_f##SEW								\
+vdot_f##SEW##LMUL (const bench_f##SEW *a, const bench_f##SEW *b,	\
+		   size_t n)						\
+{									\
+  vfloat##SEW##m1_t acc = __riscv_vfmv_s_f_f##SEW##m1 (0, 1);		\
+  for (size_t vl; n > 0; n -= vl, a += vl, b += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vfloat##SEW##LMUL##_t va = __riscv_vle##SEW##_v_f##SEW##LMUL (a, vl); \
+      vfloat##SEW##LMUL##_t vb = __riscv_vle##SEW##_v_f##SEW##LMUL (b, vl); \
+      vfloat##SEW##LMUL##_t vp = __riscv_vfmul_vv_f##SEW##LMUL (va, vb, vl); \
+      acc = __riscv_vfredusum_vs_f##SEW##LMUL##_f##SEW##m1 (vp, acc, vl); \
+    }									\
+  return __riscv_vfmv_f_s_f##SEW##m1_f##SEW (acc);			\
+}									\
+									\
+void									\
+vrelu_f##SEW##LMUL (bench_f##SEW *d, const bench_f##SEW *a,		\
+		    size_t n)						\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl, d += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vfloat##SEW##LMUL##_t va = __riscv_vle##SEW##_v_f##SEW##LMUL (a, vl); \
+      vbool##MB##_t neg = __riscv_vmflt_vf_f##SEW##LMUL##_b##MB (va, 0, vl); \
+      vfloat##SEW##LMUL##_t z = __riscv_vfmv_v_f_f##SEW##LMUL (0, vl);	\
+      va = __riscv_vmerge_vvm_f##SEW##LMUL (va, z, neg, vl);		\
+      __riscv_vse##SEW##_v_f##SEW##LMUL (d, va, vl);			\
+    }									\
+}									\
+									\
+void									\
+vstencil_f##SEW##LMUL (bench_f##SEW *d, const bench_f##SEW *a,	\
+		       const bench_f##SEW *w, size_t n)		\
+{									\
+  for (size_t vl; n > 0; n -= vl, a += vl, d += vl)			\
+    {									\
+      vl = __riscv_vsetvl_e##SEW##LMUL (n);				\
+      vfloat##SEW##LMUL##_t r = __riscv_vfmv_v_f_f##SEW##LMUL (0, vl);	\
+      for (int k = 0; k < 5; k++)					\
+	{								\
+	  vfloat##SEW##LMUL##_t v					\
+	    = __riscv_vle##SEW##_v_f##SEW##LMUL (a + k, vl);		\
+	  r = __riscv_vfmacc_vf_f##SEW##LMUL (r, w[k], v, vl);		\
+	}								\
+      r = __riscv_vfmax_vv_f##SEW##LMUL (r,				\
+	__riscv_vfsqrt_v_f##SEW##LMUL (__riscv_vfabs_v_f##SEW##LMUL (r, vl), \
+				       vl), vl);			\
+      __riscv_vse##SEW##_v_f##SEW##LMUL (d, r, vl);			\
+    }									\
+}
+
+typedef float bench_f32;
+typedef double bench_f64;
+
+INT_KERNELS (8, m1, 8)
+INT_KERNELS (8, m2, 4)
+INT_KERNELS (8, m4, 2)
+INT_KERNELS (8, m8, 1)
+INT_KERNELS (16, m1, 16)
+INT_KERNELS (16, m2, 8)
+INT_KERNELS (16, m4, 4)
+INT_KERNELS (16, m8, 2)
+INT_KERNELS (32, m1, 32)
+INT_KERNELS (32, m2, 16)
+INT_KERNELS (32, m4, 8)
+INT_KERNELS (32, m8, 4)
+INT_KERNELS (64, m1, 64)
+INT_KERNELS (64, m2, 32)
+INT_KERNELS (64, m4, 16)
+INT_KERNELS (64, m8, 8)
+
+FLOAT_KERNELS (32, m1, 32)
+FLOAT_KERNELS (32, m2, 16)
+FLOAT_KERNELS (32, m4, 8)
+FLOAT_KERNELS (32, m8, 4)
+FLOAT_KERNELS (64, m1, 64)
+FLOAT_KERNELS (64, m2, 32)
+FLOAT_KERNELS (64, m4, 16)
+FLOAT_KERNELS (64, m8, 8)
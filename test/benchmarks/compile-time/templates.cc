@@ -0,0 +1,286 @@
+// Template-heavy C++ translation unit for the compile-time benchmark.
+//
+// Exercises the front end and the inliner the way typical modern C++ does:
+// recursive class templates, constexpr evaluation, variadic packs,
+// std::variant/std::visit, std::tuple and many standard container
+// instantiations.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace bench {
+
+// Type lists.
+template <typename... Ts> struct type_list {};
+
+template <typename L> struct size;
+template <typename... Ts> struct size<type_list<Ts...>>
+  : std::integral_constant<std::size_t, sizeof... (Ts)> {};
+
+template <typename L, typename T> struct push_back;
+template <typename... Ts, typename T> struct push_back<type_list<Ts...>, T>
+{ using type = type_list<Ts..., T>; };
+
+template <std::size_t N> struct tag { static constexpr std::size_t value = N; };
+
+template <std::size_t N, typename Acc = type_list<>> struct make_tags
+{ using type = typename make_tags<N - 1,
+    typename push_back<Acc, tag<N - 1>>::type>::type; };
+template <typename Acc> struct make_tags<0, Acc> { using type = Acc; };
+
+template <template <typename> class F, typename L> struct map_list;
+template <template <typename> class F, typename... Ts>
+struct map_list<F, type_list<Ts...>>
+{ using type = type_list<typename F<Ts>::type...>; };
+
+template <typename T> struct to_array
+{ using type = std::array<std::uint32_t, T::value % 7 + 1>; };
+
+template <typename L> struct total_size;
+template <typename... Ts> struct total_size<type_list<Ts...>>
+{ static constexpr std::size_t value = (sizeof (Ts) + ... + 0); };
+
+using tags = make_tags<96>::type;
+using arrays = map_list<to_array, tags>::type;
+static_assert (size<arrays>::value == 96, "");
+static_assert (total_size<arrays>::value > 96, "");
+
+// Constexpr evaluation.
+constexpr std::uint64_t
+fnv1a (const char *s, std::uint64_t h = 14695981039346656037ull)
+{
+  return *s ? fnv1a (s + 1, (h ^ static_cast<unsigned char> (*s))
+                            * 1099511628211ull)
+            : h;
+}
+
+template <std::size_t N>
+constexpr std::array<std::uint32_t, N>
+make_primes ()
+{
+  std::array<std::uint32_t, N> primes{};
+  std::size_t count = 0;
+  for (std::uint32_t n = 2; count < N; ++n)
+    {
+      bool prime = true;
+      for (std::size_t i = 0; i < count && primes[i] * primes[i] <= n; ++i)
+        if (n % primes[i] == 0)
+          {
+            prime = false;
+            break;
+          }
+      if (prime)
+        primes[count++] = n;
+    }
+  return primes;
+}
+
+constexpr auto primes = make_primes<512> ();
+static_assert (primes[511] == 3671, "");
+static_assert (fnv1a ("riscv") != fnv1a ("RISCV"), "");
+
+// Recursive expression templates.
+template <typename L, typename R, typename Op> struct expr
+{
+  L l;
+  R r;
+  template <typename I> auto operator[] (I i) const
+  { return Op{} (l[i], r[i]); }
+};
+
+template <typename T> struct leaf
+{
+  const std::vector<T> *v;
+  T operator[] (std::size_t i) const { return (*v)[i]; }
+};
+
+template <typename L, typename R>
+expr<L, R, std::plus<>> operator+ (L l, R r) { return { l, r }; }
+template <typename L, typename R>
+expr<L, R, std::multiplies<>> operator* (L l, R r) { return { l, r }; }
+
+template <typename T, std::size_t Depth> struct deep_expr
+{
+  static auto make (const std::vector<T> &a, const std::vector<T> &b)
+  {
+    return deep_expr<T, Depth - 1>::make (a, b) * leaf<T>{ &b }
+           + leaf<T>{ &a };
+  }
+};
+template <typename T> struct deep_expr<T, 0>
+{
+  static auto make (const std::vector<T> &a, const std::vector<T> &)
+  { return leaf<T>{ &a }; }
+};
+
+template <typename T, std::size_t Depth>
+T
+eval_deep (const std::vector<T> &a, const std::vector<T> &b)
+{
+  auto e = deep_expr<T, Depth>::make (a, b);
+  T sum{};
+  for (std::size_t i = 0; i < a.size (); ++i)
+    sum += e[i];
+  return sum;
+}
+
+template <typename T, std::size_t... Ds>
+T
+eval_all (const std::vector<T> &a, const std::vector<T> &b,
+          std::index_sequence<Ds...>)
+{
+  return (eval_deep<T, Ds> (a, b) + ...);
+}
+
+// Variant visitation.
+struct circle { double r; };
+struct rect { double w, h; };
+struct tri { double a, b, c; };
+template <std::size_t N> struct poly { std::array<double, N> pts; };
+
+using shape = std::variant<circle, rect, tri, poly<3>, poly<4>, poly<5>,
+                           poly<6>, poly<7>, poly<8>, std::string>;
+
+template <typename... Fs> struct overloaded : Fs... { using Fs::operator()...; };
+template <typename... Fs> overloaded (Fs...) -> overloaded<Fs...>;
+
+double
+area (const shape &s)
+{
+  return std::visit (overloaded{
+      [] (const circle &c) { return 3.14159 * c.r * c.r; },
+      [] (const rect &r) { return r.w * r.h; },
+      [] (const tri &t) { return (t.a + t.b + t.c) / 2; },
+      [] (const std::string &n) { return static_cast<double> (n.size ()); },
+      [] (const auto &p) {
+        return std::accumulate (p.pts.begin (), p.pts.end (), 0.0);
+      } }, s);
+}
+
+double
+pair_area (const shape &a, const shape &b)
+{
+  return std::visit ([] (const auto &x, const auto &y) {
+      return area (shape{ x }) * area (shape{ y });
+    }, a, b);
+}
+
+// Tuples and containers.
+template <typename Tuple, std::size_t... Is>
+auto
+tuple_sum (const Tuple &t, std::index_sequence<Is...>)
+{
+  return (static_cast<double> (std::get<Is> (t)) + ...);
+}
+
+template <typename T> T from_index (std::size_t i)
+{ return static_cast<T> (i); }
+template <> std::string from_index<std::string> (std::size_t i)
+{ return std::to_string (i); }
+
+template <typename K, typename V>
+std::size_t
+use_maps (std::size_t n)
+{
+  std::map<K, V> m;
+  std::unordered_map<K, std::vector<V>> u;
+  for (std::size_t i = 0; i < n; ++i)
+    {
+      m[from_index<K> (i)] = from_index<V> (i * 3);
+      u[from_index<K> (i % 13)].push_back (from_index<V> (i));
+    }
+  std::size_t r = m.size ();
+  for (auto &kv : u)
+    {
+      std::sort (kv.second.begin (), kv.second.end (), std::greater<> ());
+      r += kv.second.size ();
+    }
+  return r;
+}
+
+template <typename... KVs> struct map_users;
+template <typename K, typename V, typename... Rest>
+struct map_users<K, V, Rest...>
+{
+  static std::size_t run (std::size_t n)
+  { return use_maps<K, V> (n) + map_users<Rest...>::run (n); }
+};
+template <> struct map_users<>
+{ static std::size_t run (std::size_t) { return 0; } };
+
+template <typename T>
+struct node
+{
+  T value;
+  std::vector<std::unique_ptr<node>> children;
+
+  template <typename F> void walk (F &&f) const
+  {
+    f (value);
+    for (const auto &c : children)
+      c->walk (f);
+  }
+};
+
+template <typename T>
+T
+tree_sum (std::size_t fanout)
+{
+  node<T> root{ T{}, {} };
+  for (std::size_t i = 0; i < fanout; ++i)
+    {
+      root.children.push_back (std::make_unique<node<T>> (
+        node<T>{ static_cast<T> (i), {} }));
+      for (std::size_t j = 0; j < fanout; ++j)
+        root.children.back ()->children.push_back (
+          std::make_unique<node<T>> (node<T>{ static_cast<T> (j), {} }));
+    }
+  T sum{};
+  root.walk ([&] (const T &v) { sum += v; });
+  return sum;
+}
+
+} // namespace bench
+
+double
+bench_templates (std::size_t n)
+{
+  using namespace bench;
+  std::vector<double> a (n, 1.5), b (n, 0.5);
+  std::vector<float> fa (n, 1.5f), fb (n, 0.5f);
+  std::vector<long> la (n, 3), lb (n, 1);
+  double r = eval_all (a, b, std::make_index_sequence<16> ());
+  r += eval_all (fa, fb, std::make_index_sequence<16> ());
+  r += eval_all (la, lb, std::make_index_sequence<16> ());
+
+  std::vector<shape> shapes{ circle{ 1 }, rect{ 2, 3 }, tri{ 3, 4, 5 },
+                             poly<5>{}, std::string ("hexagon") };
+  for (const auto &x : shapes)
+    for (const auto &y : shapes)
+      r += pair_area (x, y);
+
+  auto t = std::make_tuple (1, 2u, 3l, 4ul, 5.0f, 6.0, short (7), char (8),
+                            9ll, 10ull, static_cast<unsigned char> (11));
+  r += tuple_sum (t, std::make_index_sequence<std::tuple_size<
+                       decltype (t)>::value> ());
+
+  r += map_users<int, double, long, float, unsigned, short,
+                 std::string, int, char, long long,
+                 unsigned long, double>::run (n);
+  r += tree_sum<int> (n) + tree_sum<double> (n) + tree_sum<long> (n);
+  r += primes[n % primes.size ()];
+  return r;
+}
@@ -0,0 +1,34 @@
+// Small dynamically linked C++ program for the debugger startup benchmark.
+//
+// It links libstdc++, libm and libc, so attaching GDB to it loads the
+// symbols of the biggest shared libraries in the sysroot.
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::map<std::string, double>
+roots (int n)
+{
+  std::map<std::string, double> m;
+  for (int i = 1; i <= n; i++)
+    {
+      std::ostringstream s;
+      s << "sqrt(" << i << ")";
+      m[s.str ()] = std::sqrt (static_cast<double> (i));
+    }
+  return m;
+}
+
+int
+main (int argc, char **argv)
+{
+  std::vector<double> v;
+  for (const auto &e : roots (argc + 8))
+    v.push_back (e.second);
+  std::printf ("%zu roots, last %f\n", v.size (), v.back ());
+  return 0;
+}
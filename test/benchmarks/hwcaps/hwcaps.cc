@@ -0,0 +1,37 @@
+// Check program for the glibc-hwcaps subdirectories of the sysroot.
+//
+// It links libstdc++, libgcc_s, libm and libc, the libraries built for each
+// --with-glibc-hwcaps level, and prints the path of every object the
+// dynamic loader loaded, one "loaded: PATH" line each.
+
+#include <cmath>
+#include <cstdio>
+#include <link.h>
+#include <stdexcept>
+#include <string>
+
+static int
+print_object (struct dl_phdr_info *info, size_t, void *)
+{
+  if (info->dlpi_name && info->dlpi_name[0])
+    std::printf ("loaded: %s\n", info->dlpi_name);
+  return 0;
+}
+
+int
+main (int argc, char **argv)
+{
+  // Throw through libgcc_s's unwinder and call into libm, so that neither
+  // is dropped as not needed.
+  volatile double x = argc;
+  try
+    {
+      throw std::runtime_error (std::to_string (std::cos (x)));
+    }
+  catch (const std::exception &e)
+    {
+      std::printf ("cos(%d) = %s\n", argc, e.what ());
+    }
+  dl_iterate_phdr (print_object, nullptr);
+  return 0;
+}
@@ -0,0 +1,256 @@
+/* Check the vector math routines of libmvec against the scalar libm
+   functions element by element, then time them against a scalar loop.
+
+   Prints one PASS or FAIL line per routine, followed by the timings.  The
+   routines are called directly by their vector function ABI names, so
+   this needs neither a vectorizing compiler nor -ffast-math.  */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <riscv_vector.h>
+
+/* Allowed difference from libm, which is itself within 1 ulp.  */
+#define MAX_ULP 2
+#define COUNT 4096
+#define ITERS 20
+
+vfloat64m2_t _ZGVrNxv_sin (vfloat64m2_t);
+vfloat64m2_t _ZGVrNxv_cos (vfloat64m2_t);
+vfloat64m2_t _ZGVrNxv_exp (vfloat64m2_t);
+vfloat64m2_t _ZGVrNxv_log (vfloat64m2_t);
+vfloat64m2_t _ZGVrNxvv_pow (vfloat64m2_t, vfloat64m2_t);
+vfloat32m2_t _ZGVrNxv_sinf (vfloat32m2_t);
+vfloat32m2_t _ZGVrNxv_cosf (vfloat32m2_t);
+vfloat32m2_t _ZGVrNxv_expf (vfloat32m2_t);
+vfloat32m2_t _ZGVrNxv_logf (vfloat32m2_t);
+vfloat32m2_t _ZGVrNxvv_powf (vfloat32m2_t, vfloat32m2_t);
+
+static const struct
+{
+  const char *name;
+  vfloat64m2_t (*vec1) (vfloat64m2_t);
+  vfloat64m2_t (*vec2) (vfloat64m2_t, vfloat64m2_t);
+  double (*ref1) (double);
+  double (*ref2) (double, double);
+  double lo, hi;
+} dtests[] = {
+  { "sin", _ZGVrNxv_sin, 0, sin, 0, -1e6, 1e6 },
+  { "cos", _ZGVrNxv_cos, 0, cos, 0, -1e6, 1e6 },
+  { "exp", _ZGVrNxv_exp, 0, exp, 0, -760, 760 },
+  { "log", _ZGVrNxv_log, 0, log, 0, -1, 1e6 },
+  { "pow", 0, _ZGVrNxvv_pow, 0, pow, -1, 1e3 },
+};
+
+static const struct
+{
+  const char *name;
+  vfloat32m2_t (*vec1) (vfloat32m2_t);
+  vfloat32m2_t (*vec2) (vfloat32m2_t, vfloat32m2_t);
+  float (*ref1) (float);
+  float (*ref2) (float, float);
+  float lo, hi;
+} ftests[] = {
+  { "sinf", _ZGVrNxv_sinf, 0, sinf, 0, -1e4, 1e4 },
+  { "cosf", _ZGVrNxv_cosf, 0, cosf, 0, -1e4, 1e4 },
+  { "expf", _ZGVrNxv_expf, 0, expf, 0, -110, 100 },
+  { "logf", _ZGVrNxv_logf, 0, logf, 0, -1, 1e6 },
+  { "powf", 0, _ZGVrNxvv_powf, 0, powf, -1, 100 },
+};
+
+static const double specials[] = {
+  0.0, -0.0, 1.0, -1.0, 0.5, 2.0, INFINITY, -INFINITY, NAN, 1e-310, 1e-40,
+  1e300, -1e300, 709.7, -708.5, -745.2, 88.7, -103.9, 1e20, 1e5, 3.14159,
+};
+
+/* Room for COUNT elements plus one register group of any VLEN.  */
+static double dx[COUNT + 512], dy[COUNT + 512], dr[COUNT + 512];
+static double dref[COUNT];
+static float fx[COUNT + 1024], fy[COUNT + 1024], fr[COUNT + 1024];
+static float fref[COUNT];
+static unsigned long seed = 1;
+
+static double
+rnd (double lo, double hi)
+{
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return lo + (hi - lo) * ((seed >> 11) * 0x1p-53);
+}
+
+/* Inputs from [lo, hi], half of them uniform and half spread over the
+   exponents, followed by the special values.  The second operand of pow
+   is uniform in [lo * 40, hi / 20].  */
+static void
+fill (double *x, double *y, double lo, double hi)
+{
+  size_t n = COUNT - sizeof (specials) / sizeof (specials[0]);
+
+  for (size_t i = 0; i < n; i++)
+    {
+      if (i % 2 == 0)
+	x[i] = rnd (lo, hi);
+      else
+	x[i] = (rnd (0, 1) < 0.5 && lo < 0 ? -1 : 1)
+	       * exp2 (rnd (-60, log2 (hi)));
+      y[i] = rnd (lo * 40, hi / 20);
+    }
+  for (size_t i = n; i < COUNT; i++)
+    {
+      x[i] = specials[i - n];
+      y[i] = specials[COUNT - 1 - i];
+    }
+}
+
+static uint64_t
+ulps (double a, double b)
+{
+  int64_t ia, ib;
+
+  if ((isnan (a) && isnan (b)) || a == b)
+    return 0;
+  if (isnan (a) || isnan (b))
+    return UINT64_MAX;
+  memcpy (&ia, &a, sizeof (ia));
+  memcpy (&ib, &b, sizeof (ib));
+  if (ia < 0)
+    ia = INT64_MIN - ia;
+  if (ib < 0)
+    ib = INT64_MIN - ib;
+  return ia > ib ? ia - ib : ib - ia;
+}
+
+static uint64_t
+ulpsf (float a, float b)
+{
+  int32_t ia, ib;
+
+  if ((isnan (a) && isnan (b)) || a == b)
+    return 0;
+  if (isnan (a) || isnan (b))
+    return UINT64_MAX;
+  memcpy (&ia, &a, sizeof (ia));
+  memcpy (&ib, &b, sizeof (ib));
+  if (ia < 0)
+    ia = INT32_MIN - ia;
+  if (ib < 0)
+    ib = INT32_MIN - ib;
+  return ia > ib ? (uint64_t) ia - ib : (uint64_t) ib - ia;
+}
+
+static double
+now (void)
+{
+  return (double) clock () / CLOCKS_PER_SEC;
+}
+
+static void
+report (const char *name, double vec, double scalar)
+{
+  printf ("%-5s %8.1f ns/element, scalar %8.1f ns/element, %5.2fx\n", name,
+	  vec * 1e9 / (ITERS * COUNT), scalar * 1e9 / (ITERS * COUNT),
+	  vec > 0 ? scalar / vec : 0);
+}
+
+static void
+run_double (int t)
+{
+  size_t vl = __riscv_vsetvlmax_e64m2 ();
+  uint64_t worst = 0;
+  size_t at = 0;
+  double t0, t1, t2;
+
+  fill (dx, dy, dtests[t].lo, dtests[t].hi);
+  t0 = now ();
+  for (int it = 0; it < ITERS; it++)
+    for (size_t i = 0; i < COUNT; i += vl)
+      {
+	vfloat64m2_t x = __riscv_vle64_v_f64m2 (dx + i, vl);
+	vfloat64m2_t r = dtests[t].vec1
+	  ? dtests[t].vec1 (x)
+	  : dtests[t].vec2 (x, __riscv_vle64_v_f64m2 (dy + i, vl));
+	__riscv_vse64_v_f64m2 (dr + i, r, vl);
+      }
+  t1 = now ();
+  for (int it = 0; it < ITERS; it++)
+    for (size_t i = 0; i < COUNT; i++)
+      dref[i] = dtests[t].ref1 ? dtests[t].ref1 (dx[i])
+			      : dtests[t].ref2 (dx[i], dy[i]);
+  t2 = now ();
+  for (size_t i = 0; i < COUNT; i++)
+    {
+      uint64_t u = ulps (dr[i], dref[i]);
+
+      if (u > worst)
+	{
+	  worst = u;
+	  at = i;
+	}
+    }
+  if (worst > MAX_ULP)
+    printf ("FAIL: %s %a %a differs from libm by %llu ulp\n",
+	    dtests[t].name, dx[at], dy[at], (unsigned long long) worst);
+  else
+    printf ("PASS: %s\n", dtests[t].name);
+  report (dtests[t].name, t1 - t0, t2 - t1);
+}
+
+static void
+run_float (int t)
+{
+  size_t vl = __riscv_vsetvlmax_e32m2 ();
+  uint64_t worst = 0;
+  size_t at = 0;
+  double t0, t1, t2;
+
+  fill (dx, dy, ftests[t].lo, ftests[t].hi);
+  for (size_t i = 0; i < COUNT; i++)
+    {
+      fx[i] = dx[i];
+      fy[i] = dy[i];
+    }
+  t0 = now ();
+  for (int it = 0; it < ITERS; it++)
+    for (size_t i = 0; i < COUNT; i += vl)
+      {
+	vfloat32m2_t x = __riscv_vle32_v_f32m2 (fx + i, vl);
+	vfloat32m2_t r = ftests[t].vec1
+	  ? ftests[t].vec1 (x)
+	  : ftests[t].vec2 (x, __riscv_vle32_v_f32m2 (fy + i, vl));
+	__riscv_vse32_v_f32m2 (fr + i, r, vl);
+      }
+  t1 = now ();
+  for (int it = 0; it < ITERS; it++)
+    for (size_t i = 0; i < COUNT; i++)
+      fref[i] = ftests[t].ref1 ? ftests[t].ref1 (fx[i])
+			      : ftests[t].ref2 (fx[i], fy[i]);
+  t2 = now ();
+  for (size_t i = 0; i < COUNT; i++)
+    {
+      uint64_t u = ulpsf (fr[i], fref[i]);
+
+      if (u > worst)
+	{
+	  worst = u;
+	  at = i;
+	}
+    }
+  if (worst > MAX_ULP)
+    printf ("FAIL: %s %a %a differs from libm by %llu ulp\n",
+	    ftests[t].name, fx[at], fy[at], (unsigned long long) worst);
+  else
+    printf ("PASS: %s\n", ftests[t].name);
+  report (ftests[t].name, t1 - t0, t2 - t1);
+}
+
+int
+main (void)
+{
+  printf ("VLEN %lu\n", (unsigned long) __riscv_vsetvlmax_e8m1 () * 8);
+  for (int t = 0; t < (int) (sizeof (dtests) / sizeof (dtests[0])); t++)
+    run_double (t);
+  for (int t = 0; t < (int) (sizeof (ftests) / sizeof (ftests[0])); t++)
+    run_float (t);
+  return 0;
+}
@@ -0,0 +1,77 @@
+/* Barrier and lock scaling test for the OpenMP runtime.  With 1, 2, 4 and
+   8 threads, every thread passes BARRIERS barriers, counting the threads
+   that arrived before each one, and then takes a lock LOCKS times to bump
+   a shared counter.  Prints one PASS or FAIL line per thread count,
+   followed by the time per barrier and per lock, and, with the libgomp
+   built by this toolchain, a "spin: zawrs" or "spin: pause" line telling
+   how its spin loops waited.  */
+
+#include <omp.h>
+#include <stdio.h>
+
+#define BARRIERS 2000
+#define LOCKS 2000
+#define MAX_THREADS 8
+
+/* Set by the first spin of libgomp's cpu_relax, see
+   target-opt/spin/libgomp-futex.h.  */
+extern int __target_opt_gomp_zawrs __attribute__ ((weak));
+
+int
+main (void)
+{
+  omp_lock_t lock;
+
+  omp_init_lock (&lock);
+  for (int n = 1; n <= MAX_THREADS; n *= 2)
+    {
+      long arrived = 0, counter = 0;
+      int bad = 0, threads = 0;
+      double t0, t1, t2;
+
+      t0 = omp_get_wtime ();
+#pragma omp parallel num_threads (n) reduction (|: bad)
+      {
+	int nt = omp_get_num_threads ();
+
+#pragma omp single
+	threads = nt;
+	for (int i = 0; i < BARRIERS; i++)
+	  {
+	    long seen;
+
+	    __atomic_fetch_add (&arrived, 1, __ATOMIC_RELAXED);
+#pragma omp barrier
+	    /* Everyone has arrived at barrier I, and nobody can be past
+	       barrier I + 1 yet.  */
+	    seen = __atomic_load_n (&arrived, __ATOMIC_RELAXED);
+	    if (seen < (long) (i + 1) * nt || seen >= (long) (i + 2) * nt)
+	      bad = 1;
+	  }
+#pragma omp barrier
+#pragma omp master
+	t1 = omp_get_wtime ();
+	for (int i = 0; i < LOCKS; i++)
+	  {
+	    omp_set_lock (&lock);
+	    counter++;
+	    omp_unset_lock (&lock);
+	  }
+      }
+      t2 = omp_get_wtime ();
+
+      if (bad || counter != (long) threads * LOCKS)
+	printf ("FAIL: %d threads, barriers %s, lock counter %ld of %ld\n",
+		n, bad ? "broken" : "ok", counter, (long) threads * LOCKS);
+      else
+	printf ("PASS: %d threads\n", n);
+      printf ("%d threads: %8.2f us/barrier, %8.2f us/lock\n", n,
+	      (t1 - t0) * 1e6 / BARRIERS,
+	      (t2 - t1) * 1e6 / ((double) threads * LOCKS));
+    }
+  omp_destroy_lock (&lock);
+  if (&__target_opt_gomp_zawrs)
+    printf ("spin: %s\n", __target_opt_gomp_zawrs < 0 ? "none"
+	    : __target_opt_gomp_zawrs ? "zawrs" : "pause");
+  return 0;
+}
@@ -0,0 +1,59 @@
+/* A program with a large .bss, for timing the crt0 from its entry point to
+   main.  The check script also links it with
+
+     --defsym=__data_start=copy_dst
+     --defsym=__data_end=copy_dst+COPY_SIZE
+     --defsym=__data_load_start=copy_src
+
+   so that crt0 copies copy_src over copy_dst as it would copy .data from
+   its load address.  main checks that both were done and prints PASS or
+   FAIL.  */
+
+#include <stdio.h>
+
+#ifndef BSS_SIZE
+#define BSS_SIZE (256 * 1024)
+#endif
+#define COPY_SIZE 1024
+
+/* Odd sizes and offsets into the arrays are covered by the head and tail
+   of the ranges, which start and end wherever the linker put them.  */
+char big_bss[BSS_SIZE + 13];
+unsigned char copy_dst[COPY_SIZE] __attribute__ ((section (".data")));
+
+#define P(i) (unsigned char) ((i) * 7 + 1)
+#define P4(i) P (i), P (i + 1), P (i + 2), P (i + 3)
+#define P16(i) P4 (i), P4 (i + 4), P4 (i + 8), P4 (i + 12)
+#define P64(i) P16 (i), P16 (i + 16), P16 (i + 32), P16 (i + 48)
+#define P256(i) P64 (i), P64 (i + 64), P64 (i + 128), P64 (i + 192)
+const unsigned char copy_src[COPY_SIZE] = {
+  P256 (0), P256 (256), P256 (512), P256 (768)
+};
+
+int
+main (void)
+{
+  volatile char *bss = big_bss;
+  volatile unsigned char *dst = copy_dst;
+  int ok = 1;
+
+  for (unsigned long i = 0; i < sizeof (big_bss); i++)
+    if (bss[i] != 0)
+      {
+	printf ("FAIL: .bss byte %lu is %d\n", i, bss[i]);
+	ok = 0;
+	break;
+      }
+  for (unsigned long i = 0; i < COPY_SIZE; i++)
+    if (dst[i] != copy_src[i])
+      {
+	printf ("FAIL: .data byte %lu is %d, not %d\n", i, dst[i],
+		copy_src[i]);
+	ok = 0;
+	break;
+      }
+  if (ok)
+    printf ("PASS: %lu bytes of .bss, %d bytes of .data\n",
+	    (unsigned long) sizeof (big_bss), COPY_SIZE);
+  return 0;
+}
@@ -0,0 +1,391 @@
+/* Check the C library's memory and string routines against byte-wise
+   reference implementations over all small lengths and alignments, then
+   time them against the references.
+
+   Prints one PASS or FAIL line per routine, followed by the timings.  A
+   glibc built with --enable-glibc-string-ifunc also reports which variant
+   the IFUNC of each routine resolved to, as "variant: memcpy rvv" lines.
+   Build with -fno-builtin -fno-tree-loop-distribute-patterns so that the
+   calls reach the library and the references stay byte loops.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_LEN 300
+#define MAX_ALIGN 16
+#define BUF_SIZE (MAX_LEN + 2 * MAX_ALIGN + 64)
+
+static void *(*volatile lib_memcpy) (void *, const void *, size_t) = memcpy;
+static void *(*volatile lib_memmove) (void *, const void *, size_t) = memmove;
+static void *(*volatile lib_memset) (void *, int, size_t) = memset;
+static size_t (*volatile lib_strlen) (const char *) = strlen;
+static int (*volatile lib_strcmp) (const char *, const char *) = strcmp;
+static char *(*volatile lib_strchr) (const char *, int) = strchr;
+static void *(*volatile lib_memchr) (const void *, int, size_t) = memchr;
+
+/* Defined by the IFUNC selectors of target-opt/glibc/multiarch.  */
+extern const char *__target_opt_string_variant (const char *)
+  __attribute__ ((weak));
+
+static unsigned char buf1[BUF_SIZE], buf2[BUF_SIZE], buf3[BUF_SIZE];
+static unsigned long seed = 1;
+static int failures;
+
+static unsigned char
+rnd (void)
+{
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return seed >> 33;
+}
+
+static void
+fill (unsigned char *p, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    p[i] = rnd ();
+}
+
+/* Non-zero bytes from a small alphabet, so that strings compare equal
+   for a while and contain the searched characters.  */
+static void
+fill_str (unsigned char *p, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    p[i] = "abc\x80\xff"[rnd () % 5];
+}
+
+static int
+sign (int x)
+{
+  return (x > 0) - (x < 0);
+}
+
+__attribute__ ((noipa)) static void *
+ref_memcpy (void *d, const void *s, size_t n)
+{
+  unsigned char *dp = d;
+  const unsigned char *sp = s;
+  while (n--)
+    *dp++ = *sp++;
+  return d;
+}
+
+__attribute__ ((noipa)) static void *
+ref_memmove (void *d, const void *s, size_t n)
+{
+  unsigned char *dp = d;
+  const unsigned char *sp = s;
+  if (dp < sp)
+    while (n--)
+      *dp++ = *sp++;
+  else
+    while (n--)
+      dp[n] = sp[n];
+  return d;
+}
+
+__attribute__ ((noipa)) static void *
+ref_memset (void *d, int c, size_t n)
+{
+  unsigned char *dp = d;
+  while (n--)
+    *dp++ = c;
+  return d;
+}
+
+__attribute__ ((noipa)) static size_t
+ref_strlen (const char *s)
+{
+  size_t n = 0;
+  while (s[n])
+    n++;
+  return n;
+}
+
+__attribute__ ((noipa)) static int
+ref_strcmp (const char *a, const char *b)
+{
+  const unsigned char *p = (const unsigned char *) a;
+  const unsigned char *q = (const unsigned char *) b;
+  while (*p && *p == *q)
+    p++, q++;
+  return *p - *q;
+}
+
+__attribute__ ((noipa)) static char *
+ref_strchr (const char *s, int c)
+{
+  for (;; s++)
+    {
+      if (*s == (char) c)
+	return (char *) s;
+      if (!*s)
+	return NULL;
+    }
+}
+
+__attribute__ ((noipa)) static void *
+ref_memchr (const void *s, int c, size_t n)
+{
+  const unsigned char *p = s;
+  for (; n--; p++)
+    if (*p == (unsigned char) c)
+      return (void *) p;
+  return NULL;
+}
+
+static void
+fail (const char *fn, size_t n, size_t a1, size_t a2)
+{
+  if (failures++ < 20)
+    printf ("FAIL: %s length %lu alignment %lu/%lu\n", fn,
+	    (unsigned long) n, (unsigned long) a1, (unsigned long) a2);
+}
+
+static int
+test_memcpy (void)
+{
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n++)
+    for (size_t sa = 0; sa < MAX_ALIGN; sa++)
+      for (size_t da = 0; da < MAX_ALIGN; da += (n > 64 ? 5 : 1))
+	{
+	  fill (buf1, BUF_SIZE);
+	  fill (buf2, BUF_SIZE);
+	  memcpy (buf3, buf2, BUF_SIZE);
+	  ref_memcpy (buf3 + da, buf1 + sa, n);
+	  if (lib_memcpy (buf2 + da, buf1 + sa, n) != buf2 + da
+	      || memcmp (buf2, buf3, BUF_SIZE) != 0)
+	    fail ("memcpy", n, sa, da);
+	}
+  return failures == before;
+}
+
+static int
+test_memmove (void)
+{
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n += (n > 64 ? 7 : 1))
+    for (size_t sa = 0; sa < 2 * MAX_ALIGN; sa++)
+      for (size_t da = 0; da < 2 * MAX_ALIGN; da++)
+	{
+	  fill (buf1, BUF_SIZE);
+	  memcpy (buf3, buf1, BUF_SIZE);
+	  ref_memmove (buf3 + da, buf3 + sa, n);
+	  if (lib_memmove (buf1 + da, buf1 + sa, n) != buf1 + da
+	      || memcmp (buf1, buf3, BUF_SIZE) != 0)
+	    fail ("memmove", n, sa, da);
+	}
+  return failures == before;
+}
+
+static int
+test_memset (void)
+{
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n++)
+    for (size_t da = 0; da < MAX_ALIGN; da++)
+      {
+	int c = rnd () | (rnd () << 8);
+	fill (buf1, BUF_SIZE);
+	memcpy (buf3, buf1, BUF_SIZE);
+	ref_memset (buf3 + da, c, n);
+	if (lib_memset (buf1 + da, c, n) != buf1 + da
+	    || memcmp (buf1, buf3, BUF_SIZE) != 0)
+	  fail ("memset", n, da, 0);
+      }
+  return failures == before;
+}
+
+static int
+test_strlen (void)
+{
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n++)
+    for (size_t a = 0; a < MAX_ALIGN; a++)
+      {
+	char *s = (char *) buf1 + a;
+	fill (buf1, BUF_SIZE);
+	fill_str ((unsigned char *) s, n);
+	s[n] = 0;
+	if (lib_strlen (s) != ref_strlen (s))
+	  fail ("strlen", n, a, 0);
+      }
+  return failures == before;
+}
+
+static int
+test_strcmp (void)
+{
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n += (n > 64 ? 3 : 1))
+    for (size_t a1 = 0; a1 < MAX_ALIGN; a1++)
+      for (size_t a2 = 0; a2 < MAX_ALIGN; a2++)
+	{
+	  char *s1 = (char *) buf1 + a1, *s2 = (char *) buf2 + a2;
+	  fill (buf1, BUF_SIZE);
+	  fill (buf2, BUF_SIZE);
+	  fill_str ((unsigned char *) s1, n);
+	  memcpy (s2, s1, n);
+	  s1[n] = s2[n] = 0;
+	  /* Equal, differing at a random position, or s2 shorter.  */
+	  switch (rnd () % 3)
+	    {
+	    case 1:
+	      if (n)
+		s2[rnd () % n] = "abc\x80\xff"[rnd () % 5];
+	      break;
+	    case 2:
+	      if (n)
+		s2[rnd () % n] = 0;
+	      break;
+	    }
+	  if (sign (lib_strcmp (s1, s2)) != sign (ref_strcmp (s1, s2))
+	      || sign (lib_strcmp (s2, s1)) != sign (ref_strcmp (s2, s1)))
+	    fail ("strcmp", n, a1, a2);
+	}
+  return failures == before;
+}
+
+static int
+test_strchr (void)
+{
+  static const int chars[] = { 'a', 'c', 0x80, 0xff, 0x180, 'z', 0 };
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n++)
+    for (size_t a = 0; a < MAX_ALIGN; a++)
+      for (size_t i = 0; i < sizeof (chars) / sizeof (chars[0]); i++)
+	{
+	  char *s = (char *) buf1 + a;
+	  fill (buf1, BUF_SIZE);
+	  fill_str ((unsigned char *) s, n);
+	  s[n] = 0;
+	  if (lib_strchr (s, chars[i]) != ref_strchr (s, chars[i]))
+	    fail ("strchr", n, a, i);
+	}
+  return failures == before;
+}
+
+static int
+test_memchr (void)
+{
+  static const int chars[] = { 'a', 'c', 0x80, 0xff, 0x180, 'z', 0 };
+  int before = failures;
+  for (size_t n = 0; n <= MAX_LEN; n++)
+    for (size_t a = 0; a < MAX_ALIGN; a++)
+      for (size_t i = 0; i < sizeof (chars) / sizeof (chars[0]); i++)
+	{
+	  unsigned char *s = buf1 + a;
+	  fill (buf1, BUF_SIZE);
+	  fill_str (s, n);
+	  if (lib_memchr (s, chars[i], n) != ref_memchr (s, chars[i], n))
+	    fail ("memchr", n, a, i);
+	}
+  return failures == before;
+}
+
+/* Timing.  */
+
+#define BENCH_BYTES (4UL << 20)
+
+static unsigned char *big_src, *big_dst;
+
+static double
+seconds (void)
+{
+  return (double) clock () / CLOCKS_PER_SEC;
+}
+
+#define BENCH(fn, size, call)						\
+  do									\
+    {									\
+      size_t iters = BENCH_BYTES / (size) + 1;				\
+      double t0 = seconds ();						\
+      for (size_t i = 0; i < iters; i++)				\
+	call;								\
+      double t = seconds () - t0;					\
+      times[k++] = t > 0 ? (double) iters * (size) / t / 1e6 : 0;	\
+    }									\
+  while (0)
+
+static void
+report (const char *fn, size_t size, double lib, double ref)
+{
+  printf ("%-8s %6lu bytes: %9.1f MB/s, reference %9.1f MB/s, %5.2fx\n",
+	  fn, (unsigned long) size, lib, ref, ref > 0 ? lib / ref : 0);
+}
+
+static void
+bench (size_t size)
+{
+  double times[14];
+  int k = 0;
+
+  fill_str (big_src, size + 1);
+  big_src[size] = 0;
+  memcpy (big_dst, big_src, size + 1);
+
+  BENCH (memcpy, size, lib_memcpy (big_dst, big_src + 1, size));
+  BENCH (memcpy, size, ref_memcpy (big_dst, big_src + 1, size));
+  BENCH (memmove, size, lib_memmove (big_src + 1, big_src, size - 1));
+  BENCH (memmove, size, ref_memmove (big_src + 1, big_src, size - 1));
+  BENCH (memset, size, lib_memset (big_dst, 0x5a, size));
+  BENCH (memset, size, ref_memset (big_dst, 0x5a, size));
+  fill_str (big_src, size);
+  big_src[size] = 0;
+  memcpy (big_dst, big_src, size + 1);
+  BENCH (strlen, size, lib_strlen ((char *) big_src));
+  BENCH (strlen, size, ref_strlen ((char *) big_src));
+  BENCH (strcmp, size, lib_strcmp ((char *) big_src, (char *) big_dst));
+  BENCH (strcmp, size, ref_strcmp ((char *) big_src, (char *) big_dst));
+  BENCH (strchr, size, lib_strchr ((char *) big_src, 'z'));
+  BENCH (strchr, size, ref_strchr ((char *) big_src, 'z'));
+  BENCH (memchr, size, lib_memchr (big_src, 'z', size));
+  BENCH (memchr, size, ref_memchr (big_src, 'z', size));
+
+  report ("memcpy", size, times[0], times[1]);
+  report ("memmove", size, times[2], times[3]);
+  report ("memset", size, times[4], times[5]);
+  report ("strlen", size, times[6], times[7]);
+  report ("strcmp", size, times[8], times[9]);
+  report ("strchr", size, times[10], times[11]);
+  report ("memchr", size, times[12], times[13]);
+}
+
+int
+main (void)
+{
+  static const struct
+  {
+    const char *name;
+    int (*test) (void);
+  } tests[] = {
+    { "memcpy", test_memcpy },
+    { "memmove", test_memmove },
+    { "memset", test_memset },
+    { "strlen", test_strlen },
+    { "strcmp", test_strcmp },
+    { "strchr", test_strchr },
+    { "memchr", test_memchr },
+  };
+  static const size_t sizes[] = { 16, 256, 4096, 65536 };
+
+  for (size_t i = 0; i < sizeof (tests) / sizeof (tests[0]); i++)
+    printf ("%s: %s\n", tests[i].test () ? "PASS" : "FAIL", tests[i].name);
+  if (__target_opt_string_variant)
+    for (size_t i = 0; i < sizeof (tests) / sizeof (tests[0]); i++)
+      {
+	const char *v = __target_opt_string_variant (tests[i].name);
+	printf ("variant: %s %s\n", tests[i].name, v ? v : "none");
+      }
+
+  big_src = malloc (65536 + 64);
+  big_dst = malloc (65536 + 64);
+  if (!big_src || !big_dst)
+    return 1;
+  for (size_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+    bench (sizes[i]);
+  return failures != 0;
+}